@@ -22,7 +22,8 @@ public class GameJam : ModuleRules
                                 "UMG",
                                 "AudioMixer",
                                 "Slate",
-                                "Niagara"
+                                "Niagara",
+                                "NavigationSystem"
                         });
 
 		PrivateDependencyModuleNames.AddRange(new string[] { });
@@ -16,6 +16,7 @@
 #include "GameJam.h"
 #include "WorldManager.h"
 #include "WorldShiftEffectsComponent.h"
+#include "WorldShiftSubsystem.h"
 #include "HealthComponent.h"
 #include "TimerManager.h"
 
@@ -119,17 +120,19 @@ void AGameJamCharacter::BeginPlay()
 {
         Super::BeginPlay();
 
-        if (UWorld* World = GetWorld())
+        if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
         {
-                if (AWorldManager* Manager = AWorldManager::Get(World))
+                if (WorldShiftEffects)
                 {
-                        if (WorldShiftEffects)
-                        {
-                                Manager->OnWorldShifted.AddDynamic(WorldShiftEffects, &UWorldShiftEffectsComponent::TriggerWorldShiftEffects);
-                        }
-
-                        Manager->OnWorldShifted.AddDynamic(this, &AGameJamCharacter::HandleWorldShifted);
+                        Registry->OnWorldShiftedNative.AddUObject(WorldShiftEffects, &UWorldShiftEffectsComponent::TriggerWorldShiftEffects);
                 }
+
+                Registry->OnWorldShiftedNative.AddUObject(this, &AGameJamCharacter::HandleWorldShifted);
+        }
+
+        if (AWorldManager* Manager = AWorldManager::Get(GetWorld()))
+        {
+                Manager->ApplyWorldCollisionResponses(GetCapsuleComponent());
         }
 }
 
@@ -137,6 +140,12 @@ void AGameJamCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
         CancelFallingResetTimer();
 
+        if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
+        {
+                Registry->OnWorldShiftedNative.RemoveAll(WorldShiftEffects);
+                Registry->OnWorldShiftedNative.RemoveAll(this);
+        }
+
         Super::EndPlay(EndPlayReason);
 }
 
@@ -200,20 +209,8 @@ void AGameJamCharacter::CycleWorld(const FInputActionValue& Value)
         {
                 if (AWorldManager* WorldManager = AWorldManager::Get(World))
                 {
-                        const int32 NumWorlds = static_cast<int32>(EWorldState::Chaos) + 1;
-                        int32 CurrentIndex = static_cast<int32>(WorldManager->GetCurrentWorld());
-
-                        if (AxisValue > 0.0f)
-                        {
-                                CurrentIndex = (CurrentIndex + 1) % NumWorlds;
-                        }
-                        else if (AxisValue < 0.0f)
-                        {
-                                CurrentIndex = (CurrentIndex - 1 + NumWorlds) % NumWorlds;
-                        }
-
-                        const EWorldState NewWorld = static_cast<EWorldState>(CurrentIndex);
-                        WorldManager->SetWorld(NewWorld);
+                        // The manager's world list decides which worlds are cycled through and in what order.
+                        WorldManager->CycleWorld(AxisValue > 0.0f ? 1 : -1);
                 }
         }
 }
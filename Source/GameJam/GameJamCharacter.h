@@ -100,7 +100,6 @@ protected:
         void CycleWorld(const FInputActionValue& Value);
 
         /** Applies the health penalty whenever the active world changes. */
-        UFUNCTION()
         void HandleWorldShifted(EWorldState NewWorld);
 
 public:
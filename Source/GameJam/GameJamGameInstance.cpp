@@ -1,14 +1,66 @@
 #include "GameJamGameInstance.h"
 
+#include "Async/Async.h"
+#include "GameJam.h"
 #include "GameJamSaveGame.h"
+#include "HAL/FileManager.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/Paths.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "WorldShiftStats.h"
 
 const FString UGameJamGameInstance::LoopSaveSlot(TEXT("ThreeWorldsLoopData"));
 const int32 UGameJamGameInstance::LoopSaveUserIndex = 0;
 
+namespace GameJamSave
+{
+    /**
+     * Platforms that use FGenericSaveGameSystem, which overwrites the slot file in place.
+     * The platform save systems elsewhere (consoles, iOS) already commit a save as a whole.
+     */
+    static constexpr bool bUsesGenericSaveGameSystem = PLATFORM_DESKTOP || PLATFORM_ANDROID;
+
+    /** Mirrors FGenericSaveGameSystem::GetSaveGamePath. */
+    FString GetGenericSlotPath(const FString& SlotName)
+    {
+        return FString::Printf(TEXT("%sSaveGames/%s.sav"), *FPaths::ProjectSavedDir(), *SlotName);
+    }
+
+    /**
+     * Writes the slot through the platform save game system. With the generic system the data goes to a
+     * temporary slot first and is then moved over the real one, so a crash mid-write keeps the previous save.
+     */
+    bool WriteSlot(ISaveGameSystem& SaveSystem, const FString& SlotName, int32 UserIndex, const TArray<uint8>& Data)
+    {
+        if (!bUsesGenericSaveGameSystem)
+        {
+            return SaveSystem.SaveGame(false, *SlotName, UserIndex, Data);
+        }
+
+        const FString TempSlotName = SlotName + TEXT(".tmp");
+        if (!SaveSystem.SaveGame(false, *TempSlotName, UserIndex, Data))
+        {
+            SaveSystem.DeleteGame(false, *TempSlotName, UserIndex);
+            return false;
+        }
+
+        if (!IFileManager::Get().Move(*GetGenericSlotPath(SlotName), *GetGenericSlotPath(TempSlotName), true, true))
+        {
+            SaveSystem.DeleteGame(false, *TempSlotName, UserIndex);
+            return false;
+        }
+
+        return true;
+    }
+}
+
 UGameJamGameInstance::UGameJamGameInstance()
     : LoopCount(0)
     , bDirty(false)
+    , SaveDelaySeconds(1.0f)
+    , MaxGhostLoops(24)
+    , NextGhostLoopSlot(0)
 {
 }
 
@@ -21,10 +73,7 @@ void UGameJamGameInstance::Init()
 
 void UGameJamGameInstance::Shutdown()
 {
-    if (bDirty)
-    {
-        SaveLoopData();
-    }
+    FlushSave();
 
     Super::Shutdown();
 }
@@ -44,6 +93,30 @@ void UGameJamGameInstance::ResetLoopCount()
     ApplyLoopCount(0);
 }
 
+void UGameJamGameInstance::AddGhostLoop(FGhostLoopRecording&& Recording)
+{
+    if (MaxGhostLoops <= 0)
+    {
+        return;
+    }
+
+    if (GhostLoops.Num() < MaxGhostLoops)
+    {
+        GhostLoops.Add(MoveTemp(Recording));
+        return;
+    }
+
+    NextGhostLoopSlot %= GhostLoops.Num();
+    GhostLoops[NextGhostLoopSlot] = MoveTemp(Recording);
+    NextGhostLoopSlot = (NextGhostLoopSlot + 1) % GhostLoops.Num();
+}
+
+void UGameJamGameInstance::ClearGhostLoops()
+{
+    GhostLoops.Reset();
+    NextGhostLoopSlot = 0;
+}
+
 void UGameJamGameInstance::LoadLoopData()
 {
     ActiveSave = nullptr;
@@ -72,17 +145,103 @@ void UGameJamGameInstance::LoadLoopData()
     OnHintCollectionChanged.Broadcast();
 }
 
-void UGameJamGameInstance::SaveLoopData()
+void UGameJamGameInstance::SaveLoopData(bool bBlocking)
 {
+    GetTimerManager().ClearTimer(SaveTimerHandle);
+
     if (!ActiveSave)
     {
         return;
     }
 
-    ActiveSave->LoopCount = LoopCount;
-    ActiveSave->PersistentHints = GatherPersistentHints();
-    UGameplayStatics::SaveGameToSlot(ActiveSave, LoopSaveSlot, LoopSaveUserIndex);
+    // Writes are serialized so an older snapshot can never replace a newer one.
+    if (PendingWrite.IsValid() && !PendingWrite.IsReady())
+    {
+        if (!bBlocking)
+        {
+            bDirty = true;
+            ArmSaveTimer();
+            return;
+        }
+
+        PendingWrite.Wait();
+    }
+
+    TArray<uint8> Data;
+    {
+        WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftSerializeSave);
+
+        ActiveSave->LoopCount = LoopCount;
+        ActiveSave->PersistentHints = GatherPersistentHints();
+        if (!UGameplayStatics::SaveGameToMemory(ActiveSave, Data))
+        {
+            UE_LOG(LogGameJam, Error, TEXT("Failed to serialize save data for slot %s"), *LoopSaveSlot);
+            return;
+        }
+    }
+
     bDirty = false;
+
+    ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+    if (!SaveSystem)
+    {
+        UE_LOG(LogGameJam, Error, TEXT("No save game system available to write slot %s"), *LoopSaveSlot);
+        return;
+    }
+
+    PendingWrite = Async(EAsyncExecution::ThreadPool,
+        [SaveSystem, Data = MoveTemp(Data), SlotName = LoopSaveSlot, UserIndex = LoopSaveUserIndex]()
+        {
+            const bool bSaved = GameJamSave::WriteSlot(*SaveSystem, SlotName, UserIndex, Data);
+            if (!bSaved)
+            {
+                UE_LOG(LogGameJam, Error, TEXT("Failed to write save data to slot %s"), *SlotName);
+            }
+            return bSaved;
+        });
+
+    if (bBlocking)
+    {
+        PendingWrite.Wait();
+    }
+}
+
+void UGameJamGameInstance::MarkSaveDirty()
+{
+    bDirty = true;
+
+    // The timer is not restarted by later changes, so a steady stream of changes is still written every SaveDelaySeconds.
+    if (!GetTimerManager().IsTimerActive(SaveTimerHandle))
+    {
+        ArmSaveTimer();
+    }
+}
+
+void UGameJamGameInstance::ArmSaveTimer()
+{
+    GetTimerManager().SetTimer(SaveTimerHandle, this, &UGameJamGameInstance::HandleSaveTimer, FMath::Max(SaveDelaySeconds, KINDA_SMALL_NUMBER), false);
+}
+
+void UGameJamGameInstance::HandleSaveTimer()
+{
+    if (bDirty)
+    {
+        SaveLoopData();
+    }
+}
+
+void UGameJamGameInstance::FlushSave()
+{
+    GetTimerManager().ClearTimer(SaveTimerHandle);
+
+    if (bDirty)
+    {
+        SaveLoopData(true);
+    }
+    else if (PendingWrite.IsValid())
+    {
+        PendingWrite.Wait();
+    }
 }
 
 void UGameJamGameInstance::ApplyLoopCount(int32 NewLoopCount, bool bFromLoad)
@@ -97,13 +256,12 @@ void UGameJamGameInstance::ApplyLoopCount(int32 NewLoopCount, bool bFromLoad)
     }
 
     LoopCount = NewLoopCount;
-    bDirty = !bFromLoad;
 
     CheckFutureHints(LoopCount);
 
     if (!bFromLoad)
     {
-        SaveLoopData();
+        MarkSaveDirty();
     }
 
     OnLoopCountChanged.Broadcast(LoopCount);
@@ -141,7 +299,7 @@ bool UGameJamGameInstance::AddHint(FName HintID, const FText& HintText, bool bIs
 
     if (NewHint.bIsPersistent)
     {
-        SaveLoopData();
+        MarkSaveDirty();
     }
 
     return true;
@@ -166,7 +324,7 @@ bool UGameJamGameInstance::RevealHint(FName HintID)
 
             if (Hint->bIsPersistent)
             {
-                SaveLoopData();
+                MarkSaveDirty();
             }
 
             return true;
@@ -244,7 +402,7 @@ void UGameJamGameInstance::ClearHintsOnReset()
 
     if (bRequiresSave)
     {
-        SaveLoopData();
+        MarkSaveDirty();
     }
 }
 
@@ -254,8 +412,7 @@ void UGameJamGameInstance::ClearAllHints()
     {
         // Even when nothing changes we still need to notify listeners so they can refresh.
         OnHintCollectionChanged.Broadcast();
-        bDirty = true;
-        SaveLoopData();
+        MarkSaveDirty();
         return;
     }
 
@@ -263,8 +420,7 @@ void UGameJamGameInstance::ClearAllHints()
 
     OnHintCollectionChanged.Broadcast();
 
-    bDirty = true;
-    SaveLoopData();
+    MarkSaveDirty();
 }
 
 void UGameJamGameInstance::CheckFutureHints(int32 CurrentLoop)
@@ -299,7 +455,7 @@ void UGameJamGameInstance::CheckFutureHints(int32 CurrentLoop)
 
     if (bRequiresSave)
     {
-        SaveLoopData();
+        MarkSaveDirty();
     }
 }
 
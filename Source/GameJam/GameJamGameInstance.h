@@ -2,7 +2,10 @@
 
 #include "CoreMinimal.h"
 #include "Engine/GameInstance.h"
+#include "GhostReplay.h"
 #include "HintTypes.h"
+#include "Async/Future.h"
+#include "TimerManager.h"
 #include "GameJamGameInstance.generated.h"
 
 class UGameJamSaveGame;
@@ -77,6 +80,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Hints")
     void HandleWorldReset();
 
+    /** Stores a finished loop recording, replacing the oldest one once MaxGhostLoops are kept. */
+    void AddGhostLoop(FGhostLoopRecording&& Recording);
+
+    /** Returns the stored loop recordings in no particular order. */
+    const TArray<FGhostLoopRecording>& GetGhostLoops() const { return GhostLoops; }
+
+    /** Drops every stored loop recording. */
+    UFUNCTION(BlueprintCallable, Category = "Ghosts")
+    void ClearGhostLoops();
+
     /** Broadcast whenever the loop count changes. */
     UPROPERTY(BlueprintAssignable, Category = "Loop")
     FOnLoopCountChanged OnLoopCountChanged;
@@ -93,8 +106,19 @@ protected:
     /** Loads the loop data from disk or creates a new save when none exists. */
     void LoadLoopData();
 
-    /** Writes the current loop data to disk. */
-    void SaveLoopData();
+    /**
+     * Serializes the current loop data and hands it to the platform save game system on a background task.
+     * Where that system writes the slot file in place, the data is written to a temporary slot and moved over it.
+     * If the previous write is still running the save is deferred to the next timer instead, unless bBlocking
+     * is set, in which case the call waits for it and returns only once the new data is written.
+     */
+    void SaveLoopData(bool bBlocking = false);
+
+    /** Flags the loop data as changed. Changes made within SaveDelaySeconds are written together. */
+    void MarkSaveDirty();
+
+    /** Waits for the write in flight and synchronously writes any unsaved changes. */
+    void FlushSave();
 
     /** Helper used to apply the supplied loop count and notify listeners. */
     void ApplyLoopCount(int32 NewLoopCount, bool bFromLoad = false);
@@ -120,9 +144,35 @@ private:
     UPROPERTY(BlueprintReadOnly, Category = "Loop", meta = (AllowPrivateAccess = "true"))
     int32 LoopCount;
 
-    /** Tracks whether the save data needs to be written to disk during shutdown. */
+    /** Tracks whether the save data has changed since it was last serialized. */
     bool bDirty;
 
+    /** Seconds between the first unsaved change and the background write that stores it. */
+    UPROPERTY(EditDefaultsOnly, Category = "Loop", meta = (ClampMin = "0.0"))
+    float SaveDelaySeconds;
+
+    /** Fires SaveLoopData once SaveDelaySeconds have passed since the first unsaved change. */
+    FTimerHandle SaveTimerHandle;
+
+    /** Background write in flight, if any. Only one write runs at a time. */
+    TFuture<bool> PendingWrite;
+
+    /** Starts SaveTimerHandle, replacing any timer already running. */
+    void ArmSaveTimer();
+
+    /** Called by SaveTimerHandle. */
+    void HandleSaveTimer();
+
+    /** Number of previous loops kept for ghost replays. Each recording is a few kilobytes per minute. */
+    UPROPERTY(EditDefaultsOnly, Category = "Ghosts", meta = (ClampMin = "0"))
+    int32 MaxGhostLoops;
+
+    /** Ring buffer of the most recent loop recordings. Kept in memory only. */
+    TArray<FGhostLoopRecording> GhostLoops;
+
+    /** Slot in GhostLoops overwritten by the next recording once the ring is full. */
+    int32 NextGhostLoopSlot;
+
     /** Collection of hints that the player has encountered. */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Hints", meta = (AllowPrivateAccess = "true"))
     TMap<FName, FHintData> KnownHints;
@@ -0,0 +1,114 @@
+#include "GhostReplay.h"
+
+namespace GhostReplayCodec
+{
+    void WriteVarInt(TArray<uint8>& Data, int32 Value)
+    {
+        // Zigzag so small negative residuals stay small.
+        uint32 Bits = (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+        while (Bits >= 0x80)
+        {
+            Data.Add(static_cast<uint8>(Bits | 0x80));
+            Bits >>= 7;
+        }
+        Data.Add(static_cast<uint8>(Bits));
+    }
+
+    bool ReadVarInt(const TArray<uint8>& Data, int32& Offset, int32& OutValue)
+    {
+        uint32 Bits = 0;
+        for (int32 Shift = 0; Shift < 35; Shift += 7)
+        {
+            if (!Data.IsValidIndex(Offset))
+            {
+                return false;
+            }
+
+            const uint8 Byte = Data[Offset++];
+            Bits |= static_cast<uint32>(Byte & 0x7F) << Shift;
+            if ((Byte & 0x80) == 0)
+            {
+                OutValue = static_cast<int32>(Bits >> 1) ^ -static_cast<int32>(Bits & 1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
+
+FGhostReplaySample FGhostReplaySample::Quantize(const FVector& InLocation, float InYawDegrees, EWorldState InWorld, bool bFalling, float GroundSpeed)
+{
+    FGhostReplaySample Sample;
+    Sample.Location = FIntVector(FMath::RoundToInt(InLocation.X), FMath::RoundToInt(InLocation.Y), FMath::RoundToInt(InLocation.Z));
+    Sample.Yaw = static_cast<uint8>(FMath::RoundToInt(FRotator::ClampAxis(InYawDegrees) * (256.0f / 360.0f)) & 0xFF);
+    Sample.WorldIndex = static_cast<uint8>(InWorld) & (MaxWorldStates - 1);
+
+    const int32 SpeedBucket = FMath::Clamp(FMath::RoundToInt(GroundSpeed / AnimSpeedStep), 0, 15);
+    Sample.AnimState = static_cast<uint8>((bFalling ? 1 : 0) | (SpeedBucket << 1));
+    return Sample;
+}
+
+void FGhostRecordingWriter::Reset(float InSampleInterval, int32 InLoopIndex)
+{
+    Recording = FGhostLoopRecording();
+    Recording.SampleInterval = InSampleInterval;
+    Recording.LoopIndex = InLoopIndex;
+    Previous = FIntVector::ZeroValue;
+    PreviousDelta = FIntVector::ZeroValue;
+}
+
+void FGhostRecordingWriter::Append(const FGhostReplaySample& Sample)
+{
+    static_assert(MaxWorldStates <= 8, "The world index is packed into three bits.");
+
+    TArray<uint8>& Data = Recording.Data;
+    Data.Add(Sample.Yaw);
+    Data.Add(static_cast<uint8>(Sample.WorldIndex | (Sample.AnimState << 3)));
+
+    const FIntVector Residual = Sample.Location - (Previous + PreviousDelta);
+    GhostReplayCodec::WriteVarInt(Data, Residual.X);
+    GhostReplayCodec::WriteVarInt(Data, Residual.Y);
+    GhostReplayCodec::WriteVarInt(Data, Residual.Z);
+
+    PreviousDelta = Sample.Location - Previous;
+    Previous = Sample.Location;
+    ++Recording.NumSamples;
+}
+
+FGhostLoopRecording FGhostRecordingWriter::Finish()
+{
+    FGhostLoopRecording Finished = MoveTemp(Recording);
+    Finished.Data.Shrink();
+    Reset(Finished.SampleInterval, INDEX_NONE);
+    return Finished;
+}
+
+bool FGhostRecordingReader::Next(FGhostReplaySample& OutSample)
+{
+    if (!Recording || NextIndex >= Recording->NumSamples || Offset + 2 > Recording->Data.Num())
+    {
+        return false;
+    }
+
+    const TArray<uint8>& Data = Recording->Data;
+    OutSample.Yaw = Data[Offset++];
+    const uint8 State = Data[Offset++];
+    OutSample.WorldIndex = State & 0x07;
+    OutSample.AnimState = State >> 3;
+
+    FIntVector Residual;
+    if (!GhostReplayCodec::ReadVarInt(Data, Offset, Residual.X)
+        || !GhostReplayCodec::ReadVarInt(Data, Offset, Residual.Y)
+        || !GhostReplayCodec::ReadVarInt(Data, Offset, Residual.Z))
+    {
+        NextIndex = Recording->NumSamples;
+        return false;
+    }
+
+    OutSample.Location = Previous + PreviousDelta + Residual;
+    PreviousDelta = OutSample.Location - Previous;
+    Previous = OutSample.Location;
+    ++NextIndex;
+    return true;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldShiftTypes.h"
+
+/**
+ * One quantized sample of the player's trajectory. Positions are whole centimeters, rotation is yaw only
+ * in 256 steps, and the animation state is packed into five bits.
+ */
+struct FGhostReplaySample
+{
+    FIntVector Location = FIntVector::ZeroValue;
+
+    /** Yaw in 1/256 turns. */
+    uint8 Yaw = 0;
+
+    /** Active world index, below MaxWorldStates. */
+    uint8 WorldIndex = 0;
+
+    /** Bit 0 is set while falling, bits 1-4 hold the ground speed in AnimSpeedStep buckets. */
+    uint8 AnimState = 0;
+
+    /** Ground speed covered by one animation speed bucket, in cm/s. */
+    static constexpr float AnimSpeedStep = 100.0f;
+
+    static FGhostReplaySample Quantize(const FVector& InLocation, float InYawDegrees, EWorldState InWorld, bool bFalling, float GroundSpeed);
+
+    FVector GetLocation() const { return FVector(Location); }
+    float GetYawDegrees() const { return Yaw * (360.0f / 256.0f); }
+    bool IsFalling() const { return (AnimState & 1) != 0; }
+    float GetGroundSpeed() const { return (AnimState >> 1) * AnimSpeedStep; }
+};
+
+/**
+ * Trajectory of one loop. Samples are stored as a yaw byte, a world/animation byte and three zigzag
+ * varints holding the position's deviation from a constant-velocity prediction, so steady movement
+ * costs five bytes per sample.
+ */
+struct FGhostLoopRecording
+{
+    TArray<uint8> Data;
+
+    int32 NumSamples = 0;
+
+    /** Seconds between two samples. */
+    float SampleInterval = 1.0f / 15.0f;
+
+    /** Loop count at the time the loop was played. */
+    int32 LoopIndex = INDEX_NONE;
+
+    float GetDuration() const { return NumSamples * SampleInterval; }
+};
+
+/** Appends quantized samples to a recording. */
+class FGhostRecordingWriter
+{
+public:
+    /** Starts a new recording, dropping any samples from the previous one. */
+    void Reset(float InSampleInterval, int32 InLoopIndex);
+
+    void Append(const FGhostReplaySample& Sample);
+
+    const FGhostLoopRecording& GetRecording() const { return Recording; }
+
+    /** Hands the recording over and leaves the writer empty. */
+    FGhostLoopRecording Finish();
+
+private:
+    FGhostLoopRecording Recording;
+    FIntVector Previous = FIntVector::ZeroValue;
+    FIntVector PreviousDelta = FIntVector::ZeroValue;
+};
+
+/** Decodes a recording front to back. Playback only moves forward, so no seek table is kept. */
+class FGhostRecordingReader
+{
+public:
+    explicit FGhostRecordingReader(const FGhostLoopRecording* InRecording = nullptr) : Recording(InRecording) {}
+
+    /** Decodes the next sample. Returns false once every sample has been read. */
+    bool Next(FGhostReplaySample& OutSample);
+
+    /** Index of the sample the next call to Next returns. */
+    int32 GetNextIndex() const { return NextIndex; }
+
+private:
+    const FGhostLoopRecording* Recording;
+    int32 Offset = 0;
+    int32 NextIndex = 0;
+    FIntVector Previous = FIntVector::ZeroValue;
+    FIntVector PreviousDelta = FIntVector::ZeroValue;
+};
@@ -0,0 +1,269 @@
+#include "GhostReplaySubsystem.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameJamGameInstance.h"
+#include "Kismet/GameplayStatics.h"
+#include "Materials/MaterialInterface.h"
+#include "WorldManager.h"
+#include "WorldShiftStats.h"
+
+namespace GhostReplay
+{
+    /** World index, falling flag and ground speed. */
+    constexpr int32 NumCustomDataFloats = 3;
+}
+
+UGhostReplaySubsystem* UGhostReplaySubsystem::Get(const UWorld* World)
+{
+    return World ? World->GetSubsystem<UGhostReplaySubsystem>() : nullptr;
+}
+
+void UGhostReplaySubsystem::Deinitialize()
+{
+    bRecording = false;
+    Ghosts.Reset();
+    PlaybackLoops.Reset();
+    DestroyRenderer();
+
+    Super::Deinitialize();
+}
+
+void UGhostReplaySubsystem::StartLoop()
+{
+    Ghosts.Reset();
+    PlaybackTime = 0.0f;
+    PlaybackCursor = 0;
+
+    bRecording = Settings.bEnabled;
+    RecordedTime = 0.0f;
+    TimeToNextSample = 0.0f;
+
+    const UGameJamGameInstance* GameInstance = Cast<UGameJamGameInstance>(UGameplayStatics::GetGameInstance(this));
+    Writer.Reset(1.0f / FMath::Max(Settings.SampleRate, 1.0f), GameInstance ? GameInstance->GetLoopCount() : INDEX_NONE);
+
+    // Copied so readers stay valid if the game instance's ring changes during the loop; recordings are a few KB each.
+    PlaybackLoops.Reset();
+    if (Settings.bEnabled && GameInstance && Settings.GhostMesh)
+    {
+        PlaybackLoops = GameInstance->GetGhostLoops();
+    }
+
+    for (const FGhostLoopRecording& Recording : PlaybackLoops)
+    {
+        FGhostPlayback Ghost;
+        Ghost.Reader = FGhostRecordingReader(&Recording);
+        Ghost.SampleInterval = Recording.SampleInterval;
+        if (!Ghost.Reader.Next(Ghost.From))
+        {
+            continue;
+        }
+
+        Ghost.bFinished = !Ghost.Reader.Next(Ghost.To);
+        Ghost.ToTime = Recording.SampleInterval;
+        Ghosts.Add(MoveTemp(Ghost));
+    }
+
+    PrepareRenderer();
+}
+
+void UGhostReplaySubsystem::FinishLoop()
+{
+    if (!bRecording)
+    {
+        return;
+    }
+
+    bRecording = false;
+
+    if (Writer.GetRecording().NumSamples == 0)
+    {
+        return;
+    }
+
+    if (UGameJamGameInstance* GameInstance = Cast<UGameJamGameInstance>(UGameplayStatics::GetGameInstance(this)))
+    {
+        GameInstance->AddGhostLoop(Writer.Finish());
+    }
+}
+
+void UGhostReplaySubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (bRecording)
+    {
+        UpdateRecording(DeltaTime);
+    }
+
+    if (Ghosts.Num() > 0)
+    {
+        PlaybackTime += DeltaTime;
+        UpdatePlayback();
+    }
+}
+
+bool UGhostReplaySubsystem::IsRecordingFull() const
+{
+    const float MaxBytes = Settings.MaxKilobytesPerMinute * 1024.0f * (Settings.MaxRecordedSeconds / 60.0f);
+    return RecordedTime >= Settings.MaxRecordedSeconds || Writer.GetRecording().Data.Num() >= MaxBytes;
+}
+
+void UGhostReplaySubsystem::UpdateRecording(float DeltaTime)
+{
+    RecordedTime += DeltaTime;
+    TimeToNextSample -= DeltaTime;
+    if (TimeToNextSample > 0.0f)
+    {
+        return;
+    }
+
+    if (IsRecordingFull())
+    {
+        // Keep what was recorded; FinishLoop still stores it.
+        bRecording = false;
+        return;
+    }
+
+    const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+    if (!PlayerPawn)
+    {
+        return;
+    }
+
+    // Carries the remainder so the average rate matches SampleRate even when frames are uneven.
+    const float SampleInterval = Writer.GetRecording().SampleInterval;
+    TimeToNextSample = FMath::Max(TimeToNextSample + SampleInterval, 0.0f);
+
+    bool bFalling = false;
+    float GroundSpeed = PlayerPawn->GetVelocity().Size2D();
+    if (const ACharacter* Character = Cast<ACharacter>(PlayerPawn))
+    {
+        if (const UCharacterMovementComponent* Movement = Character->GetCharacterMovement())
+        {
+            bFalling = Movement->IsFalling();
+        }
+    }
+
+    const AWorldManager* Manager = AWorldManager::Get(GetWorld());
+    const EWorldState World = Manager ? Manager->GetCurrentWorld() : EWorldState::Light;
+
+    Writer.Append(FGhostReplaySample::Quantize(PlayerPawn->GetActorLocation(), PlayerPawn->GetActorRotation().Yaw, World, bFalling, GroundSpeed));
+}
+
+void UGhostReplaySubsystem::UpdatePlayback()
+{
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftGhostPlayback);
+
+    if (!GhostInstances)
+    {
+        return;
+    }
+
+    const double BudgetSeconds = Settings.PlaybackBudgetMicroseconds * 1.0e-6;
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 NumGhosts = Ghosts.Num();
+
+    int32 NumUpdated = 0;
+    for (; NumUpdated < NumGhosts; ++NumUpdated)
+    {
+        if (NumUpdated > 0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+        {
+            break;
+        }
+
+        const int32 GhostIndex = (PlaybackCursor + NumUpdated) % NumGhosts;
+        FGhostPlayback& Ghost = Ghosts[GhostIndex];
+
+        // Skipped frames are caught up here, one sample decode per elapsed interval.
+        while (!Ghost.bFinished && PlaybackTime >= Ghost.ToTime)
+        {
+            Ghost.From = Ghost.To;
+            Ghost.bFinished = !Ghost.Reader.Next(Ghost.To);
+            Ghost.ToTime += Ghost.SampleInterval;
+        }
+
+        FTransform Transform = FTransform::Identity;
+        if (Ghost.bFinished)
+        {
+            // The recorded loop is over; park the instance until the next loop restarts it.
+            Transform.SetScale3D(FVector::ZeroVector);
+        }
+        else
+        {
+            const float Alpha = FMath::Clamp(1.0f - (Ghost.ToTime - PlaybackTime) / Ghost.SampleInterval, 0.0f, 1.0f);
+            const FQuat FromRotation(FRotator(0.0f, Ghost.From.GetYawDegrees(), 0.0f));
+            const FQuat ToRotation(FRotator(0.0f, Ghost.To.GetYawDegrees(), 0.0f));
+            Transform.SetLocation(FMath::Lerp(Ghost.From.GetLocation(), Ghost.To.GetLocation(), Alpha));
+            Transform.SetRotation(FQuat::Slerp(FromRotation, ToRotation, Alpha));
+        }
+
+        const FGhostReplaySample& Current = Ghost.From;
+        const float CustomData[GhostReplay::NumCustomDataFloats] =
+        {
+            static_cast<float>(Current.WorldIndex),
+            Current.IsFalling() ? 1.0f : 0.0f,
+            Current.GetGroundSpeed()
+        };
+
+        GhostInstances->UpdateInstanceTransform(GhostIndex, Transform, true, false, true);
+        GhostInstances->SetCustomData(GhostIndex, CustomData, false);
+    }
+
+    PlaybackCursor = (PlaybackCursor + NumUpdated) % NumGhosts;
+    GhostInstances->MarkRenderStateDirty();
+
+    SET_DWORD_STAT(STAT_WorldShiftGhostsSkipped, NumGhosts - NumUpdated);
+}
+
+void UGhostReplaySubsystem::PrepareRenderer()
+{
+    if (Ghosts.Num() == 0)
+    {
+        if (GhostInstances)
+        {
+            GhostInstances->ClearInstances();
+        }
+        return;
+    }
+
+    if (!GhostInstances)
+    {
+        GhostInstances = NewObject<UInstancedStaticMeshComponent>(this);
+        GhostInstances->SetMobility(EComponentMobility::Movable);
+        GhostInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        GhostInstances->SetCastShadow(false);
+        GhostInstances->NumCustomDataFloats = GhostReplay::NumCustomDataFloats;
+        GhostInstances->RegisterComponentWithWorld(GetWorld());
+    }
+
+    GhostInstances->SetStaticMesh(Settings.GhostMesh);
+    GhostInstances->SetMaterial(0, Settings.GhostMaterial);
+
+    if (GhostInstances->GetInstanceCount() != Ghosts.Num())
+    {
+        GhostInstances->ClearInstances();
+
+        TArray<FTransform> Transforms;
+        Transforms.Init(FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), Ghosts.Num());
+        GhostInstances->AddInstances(Transforms, false, true);
+    }
+}
+
+void UGhostReplaySubsystem::DestroyRenderer()
+{
+    if (GhostInstances)
+    {
+        GhostInstances->DestroyComponent();
+        GhostInstances = nullptr;
+    }
+}
+
+TStatId UGhostReplaySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UGhostReplaySubsystem, STATGROUP_Tickables);
+}
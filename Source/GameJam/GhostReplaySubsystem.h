@@ -0,0 +1,137 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GhostReplay.h"
+#include "GhostReplaySubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+
+/** Settings for recording the player's trajectory and replaying earlier loops as ghosts. */
+USTRUCT(BlueprintType)
+struct FGhostReplaySettings
+{
+    GENERATED_BODY()
+
+    /** Records every loop and replays the stored ones while the next loop plays. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ghosts")
+    bool bEnabled = true;
+
+    /** Trajectory samples recorded per second. Playback interpolates between samples. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ghosts", meta = (EditCondition = "bEnabled", ClampMin = "1.0", ClampMax = "60.0"))
+    float SampleRate = 15.0f;
+
+    /** Recording stops once the loop is this long. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ghosts", meta = (EditCondition = "bEnabled", ClampMin = "1.0"))
+    float MaxRecordedSeconds = 600.0f;
+
+    /** Memory bound per minute of recording. Steady movement at 15 Hz needs about 5 KB per minute. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ghosts", meta = (EditCondition = "bEnabled", ClampMin = "1.0"))
+    float MaxKilobytesPerMinute = 100.0f;
+
+    /** Mesh drawn for every ghost through one instanced component. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ghosts", meta = (EditCondition = "bEnabled"))
+    TObjectPtr<UStaticMesh> GhostMesh;
+
+    /**
+     * Material for the ghost mesh. Per-instance custom data holds the recorded world index, whether the
+     * player was falling and the ground speed, for the material to animate from.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ghosts", meta = (EditCondition = "bEnabled"))
+    TObjectPtr<UMaterialInterface> GhostMaterial;
+
+    /** Game-thread time spent per frame advancing ghosts, in microseconds. Ghosts not reached catch up next frame. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ghosts", meta = (EditCondition = "bEnabled", ClampMin = "1.0"))
+    float PlaybackBudgetMicroseconds = 250.0f;
+};
+
+/**
+ * Records the player's trajectory for the current loop and replays the loops stored in
+ * UGameJamGameInstance as ghosts. Every ghost is one instance of a single instanced mesh
+ * component, so the draw cost does not grow with the number of stored loops.
+ */
+UCLASS()
+class GAMEJAM_API UGhostReplaySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Returns the subsystem for the supplied world, if any. */
+    static UGhostReplaySubsystem* Get(const UWorld* World);
+
+    /** Applies new settings. Takes effect from the next StartLoop. */
+    void SetSettings(const FGhostReplaySettings& InSettings) { Settings = InSettings; }
+
+    /** Starts recording the current loop and replays every stored loop from the beginning. */
+    void StartLoop();
+
+    /** Stops recording and stores the recorded loop in the game instance. */
+    void FinishLoop();
+
+    /** Returns the number of ghosts being replayed. */
+    int32 GetNumGhosts() const { return Ghosts.Num(); }
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual bool IsTickable() const override { return bRecording || Ghosts.Num() > 0; }
+
+protected:
+    virtual void Deinitialize() override;
+
+private:
+    /** Playback cursor of one stored loop. */
+    struct FGhostPlayback
+    {
+        FGhostRecordingReader Reader;
+        FGhostReplaySample From;
+        FGhostReplaySample To;
+
+        /** Playback time of To, in seconds. */
+        float ToTime = 0.0f;
+
+        float SampleInterval = 0.0f;
+        bool bFinished = false;
+    };
+
+    /** Samples the player pawn if a sample is due. */
+    void UpdateRecording(float DeltaTime);
+
+    /** Advances ghosts round-robin until the frame budget is used up, then pushes instance data once. */
+    void UpdatePlayback();
+
+    /** Creates the instanced ghost component on first use and sizes it to the number of ghosts. */
+    void PrepareRenderer();
+
+    void DestroyRenderer();
+
+    /** Returns whether the recording has reached either of its limits. */
+    bool IsRecordingFull() const;
+
+    FGhostReplaySettings Settings;
+
+    FGhostRecordingWriter Writer;
+
+    bool bRecording = false;
+
+    /** Seconds recorded in the current loop. */
+    float RecordedTime = 0.0f;
+
+    /** Time left until the next sample is due. */
+    float TimeToNextSample = 0.0f;
+
+    /** Recordings replayed during this loop. Ghost readers point into this array. */
+    TArray<FGhostLoopRecording> PlaybackLoops;
+
+    TArray<FGhostPlayback> Ghosts;
+
+    /** Seconds since playback started, shared by every ghost. */
+    float PlaybackTime = 0.0f;
+
+    /** First ghost updated next frame, so an exhausted budget does not starve the same ghosts every frame. */
+    int32 PlaybackCursor = 0;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UInstancedStaticMeshComponent> GhostInstances;
+};
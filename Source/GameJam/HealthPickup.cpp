@@ -4,6 +4,7 @@
 #include "Components/StaticMeshComponent.h"
 #include "HealthComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "LoopStateSubsystem.h"
 #include "Sound/SoundBase.h"
 #include "WorldShiftBehaviorComponent.h"
 #include "ShiftPlatform.h"
@@ -37,6 +38,11 @@ void AHealthPickup::BeginPlay()
 
 bool AHealthPickup::CanBeCollected() const
 {
+    if (bCollected)
+    {
+        return false;
+    }
+
     if (!WorldShiftBehavior)
     {
         return true;
@@ -64,7 +70,26 @@ void AHealthPickup::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor*
                 UGameplayStatics::PlaySoundAtLocation(this, PickupSound, GetActorLocation());
             }
 
-            Destroy();
+            SetCollected(true);
+
+            if (ULoopStateSubsystem* LoopState = ULoopStateSubsystem::Get(GetWorld()))
+            {
+                LoopState->MarkDirty(this);
+            }
         }
     }
 }
+
+void AHealthPickup::RestoreLoopState()
+{
+    SetCollected(false);
+}
+
+void AHealthPickup::SetCollected(bool bInCollected)
+{
+    bCollected = bInCollected;
+
+    // Actor-level flags override whatever the world shift behavior applies to the mesh while collected.
+    SetActorHiddenInGame(bCollected);
+    SetActorEnableCollision(!bCollected);
+}
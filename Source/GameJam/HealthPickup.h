@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "LoopResettable.h"
 #include "HealthPickup.generated.h"
 
 class USphereComponent;
@@ -10,14 +11,26 @@ class UWorldShiftBehaviorComponent;
 class USoundBase;
 class UHealthComponent;
 
+/**
+ * Heals the overlapping actor while its world behavior is solid. Collected pickups are hidden rather than
+ * destroyed so a loop reset can revive them in place.
+ */
 UCLASS()
-class GAMEJAM_API AHealthPickup : public AActor
+class GAMEJAM_API AHealthPickup : public AActor, public ILoopResettable
 {
     GENERATED_BODY()
 
 public:
     AHealthPickup();
 
+    /** Returns whether the pickup was collected during the current loop. */
+    UFUNCTION(BlueprintPure, Category = "Health")
+    bool IsCollected() const { return bCollected; }
+
+    //~ Begin ILoopResettable
+    virtual void RestoreLoopState() override;
+    //~ End ILoopResettable
+
 protected:
     virtual void BeginPlay() override;
 
@@ -49,4 +62,9 @@ private:
 
     /** Checks if the pickup is currently collectible */
     bool CanBeCollected() const;
+
+    /** Hides and disables the pickup, or brings it back. */
+    void SetCollected(bool bInCollected);
+
+    bool bCollected = false;
 };
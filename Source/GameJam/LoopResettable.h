@@ -0,0 +1,31 @@
+#pragma once
+
+#include "UObject/Interface.h"
+
+#include "LoopResettable.generated.h"
+
+/**
+ * Native interface for actors whose gameplay state is rolled back when the time loop resets.
+ * Actors capture their loop start state in BeginPlay and mark themselves dirty through
+ * ULoopStateSubsystem when it changes, so a reset only touches what actually changed.
+ */
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class GAMEJAM_API ULoopResettable : public UInterface
+{
+    GENERATED_BODY()
+};
+
+class GAMEJAM_API ILoopResettable
+{
+    GENERATED_BODY()
+
+public:
+    /** Restores the state captured at loop start. Only called on actors marked dirty since the last reset. */
+    virtual void RestoreLoopState() = 0;
+
+    /** Called when the actor is handed out by ULoopStateSubsystem::AcquireActor, after it was moved and shown. */
+    virtual void OnAcquiredFromPool() {}
+
+    /** Called when the actor is returned to the pool, before it is hidden. */
+    virtual void OnReleasedToPool() {}
+};
@@ -0,0 +1,130 @@
+#include "LoopStateSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "LoopResettable.h"
+#include "WorldShiftStats.h"
+
+ULoopStateSubsystem* ULoopStateSubsystem::Get(const UWorld* World)
+{
+    return World ? World->GetSubsystem<ULoopStateSubsystem>() : nullptr;
+}
+
+void ULoopStateSubsystem::Deinitialize()
+{
+    DirtyActors.Reset();
+    AcquiredActors.Reset();
+    FreeActors.Reset();
+
+    Super::Deinitialize();
+}
+
+void ULoopStateSubsystem::MarkDirty(AActor* Actor)
+{
+    if (!Actor || !Actor->Implements<ULoopResettable>())
+    {
+        return;
+    }
+
+    DirtyActors.Add(Actor);
+}
+
+void ULoopStateSubsystem::RestoreLoopStart()
+{
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftRestoreLoopState);
+
+    // Restoring can mark actors dirty again (e.g. a button broadcasting its reset); those wait for the next loop.
+    TSet<TWeakObjectPtr<AActor>> ActorsToRestore = MoveTemp(DirtyActors);
+    DirtyActors.Reset();
+
+    for (const TWeakObjectPtr<AActor>& WeakActor : ActorsToRestore)
+    {
+        if (ILoopResettable* Resettable = Cast<ILoopResettable>(WeakActor.Get()))
+        {
+            Resettable->RestoreLoopState();
+        }
+    }
+
+    INC_DWORD_STAT_BY(STAT_WorldShiftRestoredActors, ActorsToRestore.Num());
+
+    TArray<TWeakObjectPtr<AActor>> ActorsToRelease = MoveTemp(AcquiredActors);
+    AcquiredActors.Reset();
+
+    for (const TWeakObjectPtr<AActor>& WeakActor : ActorsToRelease)
+    {
+        if (AActor* Actor = WeakActor.Get())
+        {
+            ReturnToPool(Actor);
+        }
+    }
+}
+
+AActor* ULoopStateSubsystem::AcquireActor(TSubclassOf<AActor> ActorClass, const FTransform& Transform, const FActorSpawnParameters& SpawnParams)
+{
+    UWorld* World = GetWorld();
+    if (!World || !ActorClass)
+    {
+        return nullptr;
+    }
+
+    AActor* Actor = nullptr;
+    if (TArray<TWeakObjectPtr<AActor>>* Free = FreeActors.Find(ActorClass.Get()))
+    {
+        while (!Actor && Free->Num() > 0)
+        {
+            Actor = Free->Pop(EAllowShrinking::No).Get();
+        }
+    }
+
+    if (Actor)
+    {
+        Actor->SetOwner(SpawnParams.Owner);
+        Actor->SetInstigator(SpawnParams.Instigator);
+        Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+        Actor->SetActorHiddenInGame(false);
+        Actor->SetActorEnableCollision(true);
+        Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+    }
+    else
+    {
+        Actor = World->SpawnActor<AActor>(ActorClass, Transform, SpawnParams);
+        if (!Actor)
+        {
+            return nullptr;
+        }
+    }
+
+    AcquiredActors.Add(Actor);
+
+    if (ILoopResettable* Resettable = Cast<ILoopResettable>(Actor))
+    {
+        Resettable->OnAcquiredFromPool();
+    }
+
+    return Actor;
+}
+
+bool ULoopStateSubsystem::ReleaseActor(AActor* Actor)
+{
+    if (!Actor || AcquiredActors.RemoveSwap(Actor, EAllowShrinking::No) == 0)
+    {
+        return false;
+    }
+
+    ReturnToPool(Actor);
+    return true;
+}
+
+void ULoopStateSubsystem::ReturnToPool(AActor* Actor)
+{
+    if (ILoopResettable* Resettable = Cast<ILoopResettable>(Actor))
+    {
+        Resettable->OnReleasedToPool();
+    }
+
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
+
+    FreeActors.FindOrAdd(Actor->GetClass()).Add(Actor);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/SubclassOf.h"
+#include "LoopStateSubsystem.generated.h"
+
+struct FActorSpawnParameters;
+
+/**
+ * World subsystem that rolls level state back to loop start without reloading the level.
+ *
+ * Placed actors implementing ILoopResettable keep their own loop start state and report changes
+ * through MarkDirty; RestoreLoopStart restores only those. Actors created during a loop are taken
+ * from a per-class pool through AcquireActor and are all returned to it on reset, so collected or
+ * expired actors are revived instead of destroyed and respawned.
+ */
+UCLASS()
+class GAMEJAM_API ULoopStateSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Returns the subsystem for the supplied world, if any. */
+    static ULoopStateSubsystem* Get(const UWorld* World);
+
+    /** Queues the actor for the next RestoreLoopStart. The actor must implement ILoopResettable. */
+    void MarkDirty(AActor* Actor);
+
+    /** Restores every dirty actor and returns every actor acquired during the loop to the pool. */
+    void RestoreLoopStart();
+
+    /** Returns a pooled actor of the class moved to the transform, spawning one if the pool is empty. */
+    AActor* AcquireActor(TSubclassOf<AActor> ActorClass, const FTransform& Transform, const FActorSpawnParameters& SpawnParams);
+
+    template <typename T>
+    T* AcquireActor(TSubclassOf<T> ActorClass, const FTransform& Transform, const FActorSpawnParameters& SpawnParams)
+    {
+        return Cast<T>(AcquireActor(TSubclassOf<AActor>(ActorClass), Transform, SpawnParams));
+    }
+
+    /** Hides and disables an acquired actor and returns it to the pool. Returns false if the actor was not acquired here. */
+    bool ReleaseActor(AActor* Actor);
+
+    /** Returns the number of actors waiting to be restored. */
+    int32 GetNumDirty() const { return DirtyActors.Num(); }
+
+protected:
+    virtual void Deinitialize() override;
+
+private:
+    /** Hides, disables and stores the actor in the free list of its class. */
+    void ReturnToPool(AActor* Actor);
+
+    /** Actors changed since the last reset. A set, since the same actor is usually marked many times per loop. */
+    TSet<TWeakObjectPtr<AActor>> DirtyActors;
+
+    /** Actors handed out by AcquireActor during the current loop. */
+    TArray<TWeakObjectPtr<AActor>> AcquiredActors;
+
+    /** Released actors by class, ready to be handed out again. */
+    TMap<const UClass*, TArray<TWeakObjectPtr<AActor>>> FreeActors;
+};
@@ -1,7 +1,9 @@
 #include "ShiftPlatform.h"
 
 #include "Components/StaticMeshComponent.h"
+#include "NavModifierComponent.h"
 #include "WorldShiftBehaviorComponent.h"
+#include "WorldShiftNavigation.h"
 
 AShiftPlatform::AShiftPlatform()
 {
@@ -23,6 +25,11 @@ AShiftPlatform::AShiftPlatform()
         WorldShiftBehavior->SetGhostHintMesh(GhostHint);
     }
 
+    // Platforms whose hint mesh is left empty are hinted by the world shift registry's shared pool.
+    WorldShiftBehavior->bUseSharedGhostHintPool = true;
+
+    NavModifier = CreateDefaultSubobject<UNavModifierComponent>(TEXT("NavModifier"));
+
     PrefabType = EPlatformPrefabType::LightBridge;
 }
 
@@ -36,11 +43,38 @@ void AShiftPlatform::OnConstruction(const FTransform& Transform)
         WorldShiftBehavior->EnsureWorldBehaviorsFromPrefab(PrefabType);
         WorldShiftBehavior->RefreshGhostHintPreview(WorldShiftBehavior->CurrentWorld);
     }
+
+    UpdateNavArea();
+}
+
+void AShiftPlatform::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+
+    // The prefab profile is transient, so loaded platforms resolve it here rather than relying on construction scripts.
+    if (WorldShiftBehavior)
+    {
+        WorldShiftBehavior->EnsureWorldBehaviorsFromPrefab(PrefabType);
+    }
+
+    UpdateNavArea();
+}
+
+void AShiftPlatform::UpdateNavArea()
+{
+    if (!NavModifier || !WorldShiftBehavior)
+    {
+        return;
+    }
+
+    const FWorldStateMasks& Masks = WorldShiftBehavior->GetWorldStateMasks();
+    NavModifier->SetAreaClass(UNavArea_WorldShift::GetAreaClass(Masks.GetBlockingMask(), Masks.TimedSolid != 0));
 }
 
 /*
 Example editor setup:
-- WorldBehaviors → Light: Solid, Shadow: Ghost, Chaos: TimedSolid.
+- Profile → shared UWorldShiftProfile asset (leave empty to use the PrefabType preset).
+- WorldBehaviors → only the worlds this instance overrides, e.g. Chaos: TimedSolid.
 - SolidMaterial → assign the opaque platform material.
 - GhostMaterials → Light: light-tinted ghost, Shadow: dark-tinted ghost, Chaos: vibrant ghost hue.
 */
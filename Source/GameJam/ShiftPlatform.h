@@ -5,6 +5,7 @@
 #include "WorldShiftTypes.h"
 #include "ShiftPlatform.generated.h"
 
+class UNavModifierComponent;
 class UStaticMeshComponent;
 class UWorldShiftBehaviorComponent;
 
@@ -17,6 +18,49 @@ enum class EPlatformState : uint8
     TimedSolid UMETA(DisplayName = "Timed Solid")
 };
 
+static_assert(static_cast<uint8>(EPlatformState::Ghost) == 1 && static_cast<uint8>(EPlatformState::Hidden) == 2
+    && static_cast<uint8>(EPlatformState::TimedSolid) == 3, "FWorldStateMasks::Get decodes EPlatformState from two bits.");
+
+/**
+ * Per-world platform states of one shiftable as a bitmask per state, one bit per world index.
+ * Membership questions such as "is solid in the current world" are a single AND.
+ */
+struct FWorldStateMasks
+{
+    uint8 Solid = 0;
+    uint8 Ghost = 0;
+    uint8 Hidden = 0;
+    uint8 TimedSolid = 0;
+
+    /** Stores the state for the supplied world, clearing the world's bit from the other masks. */
+    void Set(EWorldState World, EPlatformState State)
+    {
+        const uint8 Bit = GetWorldBit(World);
+        Solid = (State == EPlatformState::Solid) ? (Solid | Bit) : (Solid & ~Bit);
+        Ghost = (State == EPlatformState::Ghost) ? (Ghost | Bit) : (Ghost & ~Bit);
+        Hidden = (State == EPlatformState::Hidden) ? (Hidden | Bit) : (Hidden & ~Bit);
+        TimedSolid = (State == EPlatformState::TimedSolid) ? (TimedSolid | Bit) : (TimedSolid & ~Bit);
+    }
+
+    /** Decodes the state for a world bit without branches, so bulk passes over many shiftables vectorize. */
+    EPlatformState GetForBit(uint8 WorldBit) const
+    {
+        const uint8 LowBit = ((Ghost | TimedSolid) & WorldBit) != 0;
+        const uint8 HighBit = ((Hidden | TimedSolid) & WorldBit) != 0;
+        return static_cast<EPlatformState>(LowBit | (HighBit << 1));
+    }
+
+    EPlatformState Get(EWorldState World) const { return GetForBit(GetWorldBit(World)); }
+
+    /** Worlds where the shiftable can block, either always or during the solid timed phase. */
+    uint8 GetBlockingMask() const { return Solid | TimedSolid; }
+
+    bool operator==(const FWorldStateMasks& Other) const
+    {
+        return Solid == Other.Solid && Ghost == Other.Ghost && Hidden == Other.Hidden && TimedSolid == Other.TimedSolid;
+    }
+};
+
 UENUM(BlueprintType)
 enum class EPlatformPrefabType : uint8
 {
@@ -40,8 +84,21 @@ class GAMEJAM_API AShiftPlatform : public AActor
 public:
     AShiftPlatform();
 
+    /** Returns the mesh driven by the world shift behavior. */
+    UStaticMeshComponent* GetPlatformMesh() const { return PlatformMesh; }
+
+    /** Returns the component holding the per-world behavior of this platform. */
+    UWorldShiftBehaviorComponent* GetWorldShiftBehavior() const { return WorldShiftBehavior; }
+
+    /** Selects the prefab preset. Only takes effect before construction, e.g. between SpawnActorDeferred and FinishSpawning. */
+    void SetPrefabType(EPlatformPrefabType InPrefabType) { PrefabType = InPrefabType; }
+
 protected:
     virtual void OnConstruction(const FTransform& Transform) override;
+    virtual void PostInitializeComponents() override;
+
+    /** Marks the platform's navmesh polygons with the worlds it can be walked in. */
+    void UpdateNavArea();
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     TObjectPtr<UStaticMeshComponent> PlatformMesh;
@@ -49,6 +106,10 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "World Shift")
     TObjectPtr<UWorldShiftBehaviorComponent> WorldShiftBehavior;
 
+    /** Applies the world shift nav area over the platform so per-world query filters can include or skip it. */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Navigation")
+    TObjectPtr<UNavModifierComponent> NavModifier;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Shift|Prefab")
     EPlatformPrefabType PrefabType;
 };
@@ -0,0 +1,244 @@
+#include "ShiftPlatformCluster.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "EngineUtils.h"
+#include "Materials/MaterialInterface.h"
+#include "WorldManager.h"
+#include "WorldShiftBehaviorComponent.h"
+#include "WorldShiftSubsystem.h"
+
+AShiftPlatformCluster::AShiftPlatformCluster()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
+
+    CollectExtent = FVector(5000.0f);
+    StateCustomDataIndex = 0;
+    CurrentWorld = EWorldState::Light;
+}
+
+void AShiftPlatformCluster::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
+    {
+        Registry->WhenWorldManagerReady(FOnWorldManagerReadyNative::FDelegate::CreateUObject(this, &AShiftPlatformCluster::HandleWorldManagerReady));
+        Registry->OnWorldShiftedNative.AddUObject(this, &AShiftPlatformCluster::HandleWorldShift);
+    }
+
+    BuildCluster();
+}
+
+void AShiftPlatformCluster::HandleWorldManagerReady(AWorldManager* Manager)
+{
+    CachedWorldManager = Manager;
+    CurrentWorld = Manager->GetCurrentWorld();
+    Manager->OnTimedSolidPhaseChanged.AddDynamic(this, &AShiftPlatformCluster::HandleTimedSolidPhaseChanged);
+    Manager->OnTimedSolidPreWarning.AddDynamic(this, &AShiftPlatformCluster::HandleTimedSolidPreWarning);
+}
+
+void AShiftPlatformCluster::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
+    {
+        Registry->OnWorldShiftedNative.RemoveAll(this);
+    }
+
+    if (AWorldManager* Manager = CachedWorldManager.Get())
+    {
+        Manager->OnTimedSolidPhaseChanged.RemoveDynamic(this, &AShiftPlatformCluster::HandleTimedSolidPhaseChanged);
+        Manager->OnTimedSolidPreWarning.RemoveDynamic(this, &AShiftPlatformCluster::HandleTimedSolidPreWarning);
+    }
+
+    CachedWorldManager.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AShiftPlatformCluster::CollectPlatforms()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    Modify();
+    SourcePlatforms.Reset();
+
+    const FBox CollectBounds = FBox::BuildAABB(GetActorLocation(), CollectExtent);
+    for (TActorIterator<AShiftPlatform> It(World); It; ++It)
+    {
+        if (CollectBounds.IsInside(It->GetActorLocation()))
+        {
+            SourcePlatforms.Add(*It);
+        }
+    }
+}
+
+void AShiftPlatformCluster::BuildCluster()
+{
+    for (AShiftPlatform* Platform : SourcePlatforms)
+    {
+        if (!IsValid(Platform))
+        {
+            continue;
+        }
+
+        UStaticMeshComponent* PlatformMesh = Platform->GetPlatformMesh();
+        const UWorldShiftBehaviorComponent* Behavior = Platform->GetWorldShiftBehavior();
+        if (!PlatformMesh || !PlatformMesh->GetStaticMesh() || !Behavior)
+        {
+            continue;
+        }
+
+        // Without a world-aware material the instances could not show ghost or pre-warning looks, so the platform
+        // stays a regular actor.
+        UMaterialInterface* Material = ClusterMaterial ? ClusterMaterial.Get() : Behavior->WorldAwareMaterial.Get();
+        if (!Material)
+        {
+            continue;
+        }
+
+        // Platforms that already began play may have switched to a membership channel; use the authored profile.
+        const UStaticMeshComponent* AuthoredMesh = Cast<UStaticMeshComponent>(PlatformMesh->GetArchetype());
+        const FName CollisionProfileName = (AuthoredMesh ? AuthoredMesh : PlatformMesh)->GetCollisionProfileName();
+
+        const int32 GroupIndex = FindOrAddGroup(PlatformMesh->GetStaticMesh(), Material, CollisionProfileName, Behavior->GetWorldStateMasks());
+        Groups[GroupIndex].Instances->AddInstance(PlatformMesh->GetComponentTransform(), true);
+
+        Platform->Destroy();
+    }
+
+    SourcePlatforms.Reset();
+
+    for (FShiftPlatformClusterGroup& Group : Groups)
+    {
+        ApplyGroupState(Group);
+    }
+}
+
+int32 AShiftPlatformCluster::GetNumInstances() const
+{
+    int32 NumInstances = 0;
+    for (const FShiftPlatformClusterGroup& Group : Groups)
+    {
+        NumInstances += Group.Instances ? Group.Instances->GetInstanceCount() : 0;
+    }
+
+    return NumInstances;
+}
+
+int32 AShiftPlatformCluster::FindOrAddGroup(UStaticMesh* Mesh, UMaterialInterface* Material, FName CollisionProfileName, const FWorldStateMasks& WorldStateMasks)
+{
+    for (int32 GroupIndex = 0; GroupIndex < Groups.Num(); ++GroupIndex)
+    {
+        const FShiftPlatformClusterGroup& Group = Groups[GroupIndex];
+        if (Group.Instances->GetStaticMesh() == Mesh
+            && Group.Material == Material
+            && Group.CollisionProfileName == CollisionProfileName
+            && Group.WorldStateMasks == WorldStateMasks)
+        {
+            return GroupIndex;
+        }
+    }
+
+    UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(this);
+    Instances->SetupAttachment(RootComponent);
+    Instances->SetStaticMesh(Mesh);
+    Instances->SetCollisionProfileName(CollisionProfileName);
+
+    const int32 MaterialCount = Instances->GetNumMaterials();
+    for (int32 MaterialIndex = 0; MaterialIndex < MaterialCount; ++MaterialIndex)
+    {
+        Instances->SetMaterial(MaterialIndex, Material);
+    }
+
+    Instances->RegisterComponent();
+
+    FShiftPlatformClusterGroup& Group = Groups.AddDefaulted_GetRef();
+    Group.Instances = Instances;
+    Group.Material = Material;
+    Group.CollisionProfileName = CollisionProfileName;
+    Group.WorldStateMasks = WorldStateMasks;
+
+    return Groups.Num() - 1;
+}
+
+void AShiftPlatformCluster::HandleWorldShift(EWorldState NewWorld)
+{
+    CurrentWorld = NewWorld;
+
+    for (FShiftPlatformClusterGroup& Group : Groups)
+    {
+        ApplyGroupState(Group);
+    }
+}
+
+void AShiftPlatformCluster::HandleTimedSolidPhaseChanged(bool bNowSolid)
+{
+    for (FShiftPlatformClusterGroup& Group : Groups)
+    {
+        if (Group.WorldStateMasks.TimedSolid != 0)
+        {
+            UpdateGroupCollision(Group);
+        }
+    }
+}
+
+void AShiftPlatformCluster::HandleTimedSolidPreWarning(bool bWillBeSolid)
+{
+    for (FShiftPlatformClusterGroup& Group : Groups)
+    {
+        if (Group.WorldStateMasks.TimedSolid != 0)
+        {
+            UpdateGroupCollision(Group);
+        }
+    }
+}
+
+void AShiftPlatformCluster::ApplyGroupState(FShiftPlatformClusterGroup& Group) const
+{
+    const EPlatformState State = Group.WorldStateMasks.Get(CurrentWorld);
+
+    // The material resolves ghost looks and the timed solid phase itself, so visuals only change on world shifts.
+    Group.Instances->SetCustomPrimitiveDataFloat(StateCustomDataIndex, static_cast<float>(State));
+    Group.Instances->SetVisibility(State != EPlatformState::Hidden);
+
+    UpdateGroupCollision(Group);
+}
+
+void AShiftPlatformCluster::UpdateGroupCollision(FShiftPlatformClusterGroup& Group) const
+{
+    const AWorldManager* Manager = CachedWorldManager.Get();
+
+    // Timed solid worlds only count while the phase is solid; the pre-warning window is already passable.
+    const bool bTimedSolidPhaseSolid = !Manager || (Manager->IsGlobalTimedSolidSolid() && !Manager->IsTimedSolidPreWarningActive());
+
+    if (Manager && Manager->UsesWorldCollisionChannels())
+    {
+        const uint8 MembershipMask = Group.WorldStateMasks.Solid | (bTimedSolidPhaseSolid ? Group.WorldStateMasks.TimedSolid : 0);
+        if (MembershipMask == Group.AppliedMembershipMask)
+        {
+            return;
+        }
+
+        if (Group.AppliedMembershipMask == INDEX_NONE)
+        {
+            Group.Instances->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+        }
+
+        Group.AppliedMembershipMask = MembershipMask;
+        Group.Instances->SetCollisionObjectType(Manager->GetWorldMembershipChannel(MembershipMask));
+        return;
+    }
+
+    const EPlatformState State = Group.WorldStateMasks.Get(CurrentWorld);
+    const bool bSolid = State == EPlatformState::Solid || (State == EPlatformState::TimedSolid && bTimedSolidPhaseSolid);
+    Group.Instances->SetCollisionEnabled(bSolid ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+}
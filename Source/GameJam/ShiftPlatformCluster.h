@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ShiftPlatform.h"
+#include "WorldShiftTypes.h"
+#include "ShiftPlatformCluster.generated.h"
+
+class AWorldManager;
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+
+/** Instanced batch of absorbed platforms that share a mesh, material, collision profile and per-world behavior. */
+USTRUCT()
+struct FShiftPlatformClusterGroup
+{
+    GENERATED_BODY()
+
+    /** Instances of every platform absorbed into this group. */
+    UPROPERTY(Transient)
+    TObjectPtr<UInstancedStaticMeshComponent> Instances;
+
+    /** World-aware material applied to the instances. */
+    UPROPERTY(Transient)
+    TObjectPtr<UMaterialInterface> Material;
+
+    /** Collision profile copied from the absorbed platform meshes. */
+    FName CollisionProfileName;
+
+    /** Per-world behavior shared by every instance in the group. */
+    FWorldStateMasks WorldStateMasks;
+
+    /** Membership bitmask last written to the instances' object type, or INDEX_NONE when none was written. */
+    int32 AppliedMembershipMask = INDEX_NONE;
+};
+
+/**
+ * Absorbs placed shift platforms into instanced static mesh components so dense sections render with one
+ * draw per mesh, material and behavior instead of one per platform. Platforms with the same behavior always
+ * share a state, so each group is driven as a whole: the state goes to custom primitive data for a
+ * world-aware material, and collision stays per instance inside the instanced component.
+ *
+ * Absorbed platforms are destroyed, so their Blueprint state events and ghost hints do not run. Only platforms
+ * with a world-aware material are absorbed, since per-state material swaps are not possible per instance.
+ */
+UCLASS()
+class GAMEJAM_API AShiftPlatformCluster : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AShiftPlatformCluster();
+
+    /** Fills SourcePlatforms with every shift platform located inside CollectExtent around this actor. */
+    UFUNCTION(CallInEditor, Category = "World Shift|Cluster")
+    void CollectPlatforms();
+
+    /** Absorbs SourcePlatforms into instanced groups and applies the current world. Runs from BeginPlay. */
+    UFUNCTION(BlueprintCallable, Category = "World Shift|Cluster")
+    void BuildCluster();
+
+    /** Returns the number of platforms rendered by this cluster. */
+    UFUNCTION(BlueprintPure, Category = "World Shift|Cluster")
+    int32 GetNumInstances() const;
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /** Platforms absorbed when the cluster is built. */
+    UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "World Shift|Cluster")
+    TArray<TObjectPtr<AShiftPlatform>> SourcePlatforms;
+
+    /** Half extent of the box around the cluster searched by CollectPlatforms. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Cluster")
+    FVector CollectExtent;
+
+    /**
+     * World-aware material applied to every instance. It reads the EPlatformState from custom primitive data
+     * and the world and timed solid phase from the world manager's parameter collection.
+     * Falls back to each platform's WorldAwareMaterial. Platforms with neither are left out of the cluster.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Cluster")
+    TObjectPtr<UMaterialInterface> ClusterMaterial;
+
+    /** Custom primitive data slot receiving the EPlatformState of the current world as a float. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Cluster", meta = (ClampMin = "0"))
+    int32 StateCustomDataIndex;
+
+private:
+    int32 FindOrAddGroup(UStaticMesh* Mesh, UMaterialInterface* Material, FName CollisionProfileName, const FWorldStateMasks& WorldStateMasks);
+
+    void HandleWorldShift(EWorldState NewWorld);
+
+    /** Binds the timed solid events once the world manager is registered. */
+    void HandleWorldManagerReady(AWorldManager* Manager);
+
+    UFUNCTION()
+    void HandleTimedSolidPhaseChanged(bool bNowSolid);
+
+    UFUNCTION()
+    void HandleTimedSolidPreWarning(bool bWillBeSolid);
+
+    /** Applies the current world's state to every instance of the group. */
+    void ApplyGroupState(FShiftPlatformClusterGroup& Group) const;
+
+    /** Updates the group's collision for the current world and timed solid phase. */
+    void UpdateGroupCollision(FShiftPlatformClusterGroup& Group) const;
+
+    UPROPERTY(Transient)
+    TArray<FShiftPlatformClusterGroup> Groups;
+
+    TWeakObjectPtr<AWorldManager> CachedWorldManager;
+
+    EWorldState CurrentWorld;
+};
@@ -3,6 +3,7 @@
 
 #include "CombatAIController.h"
 #include "Components/StateTreeAIComponent.h"
+#include "WorldShiftNavigation.h"
 
 ACombatAIController::ACombatAIController()
 {
@@ -16,4 +17,7 @@ ACombatAIController::ACombatAIController()
 	// ensure we're attached to the possessed character.
 	// this is necessary for EnvQueries to work correctly
 	bAttachToPawn = true;
+
+	// query paths through the filter the world manager swaps on every world shift
+	DefaultNavigationFilterClass = UWorldShiftNavigationQueryFilter::StaticClass();
 }
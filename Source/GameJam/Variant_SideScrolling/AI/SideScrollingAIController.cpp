@@ -3,6 +3,7 @@
 
 #include "SideScrollingAIController.h"
 #include "GameplayStateTreeModule/Public/Components/StateTreeAIComponent.h"
+#include "WorldShiftNavigation.h"
 
 ASideScrollingAIController::ASideScrollingAIController()
 {
@@ -16,4 +17,7 @@ ASideScrollingAIController::ASideScrollingAIController()
 	// ensure we're attached to the possessed character.
 	// this is necessary for EnvQueries to work correctly
 	bAttachToPawn = true;
+
+	// query paths through the filter the world manager swaps on every world shift
+	DefaultNavigationFilterClass = UWorldShiftNavigationQueryFilter::StaticClass();
 }
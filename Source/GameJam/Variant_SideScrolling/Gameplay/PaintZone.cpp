@@ -5,6 +5,7 @@
 #include "Components/PrimitiveComponent.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "LoopStateSubsystem.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Math/RotationMatrix.h"
 
@@ -38,13 +39,16 @@ void APaintZone::InitializePaintZone(EForceType InForceType, const FVector& InSu
     SurfaceNormal = InSurfaceNormal.IsNearlyZero() ? FVector::UpVector : InSurfaceNormal.GetSafeNormal();
     bPermanent = bInPermanent;
 
+    // Expiry uses a timer instead of a life span so pooled zones are reused rather than destroyed.
+    GetWorldTimerManager().ClearTimer(ExpireTimerHandle);
+
     if (!bPermanent)
     {
         if (DecalComponent)
         {
             DecalComponent->SetFadeOut(LifeTime, FadeOutDuration, false);
         }
-        SetLifeSpan(LifeTime + FadeOutDuration);
+        GetWorldTimerManager().SetTimer(ExpireTimerHandle, this, &APaintZone::Expire, LifeTime + FadeOutDuration, false);
     }
     else
     {
@@ -52,7 +56,6 @@ void APaintZone::InitializePaintZone(EForceType InForceType, const FVector& InSu
         {
             DecalComponent->SetFadeOut(0.0f, 0.0f, false);
         }
-        SetLifeSpan(0.0f);
     }
 
     UpdateVisuals();
@@ -74,6 +77,25 @@ void APaintZone::BeginPlay()
     UpdateVisuals();
 }
 
+void APaintZone::OnAcquiredFromPool()
+{
+    ElapsedTime = 0.0f;
+}
+
+void APaintZone::OnReleasedToPool()
+{
+    GetWorldTimerManager().ClearTimer(ExpireTimerHandle);
+}
+
+void APaintZone::Expire()
+{
+    ULoopStateSubsystem* LoopState = ULoopStateSubsystem::Get(GetWorld());
+    if (!LoopState || !LoopState->ReleaseActor(this))
+    {
+        Destroy();
+    }
+}
+
 void APaintZone::Tick(float DeltaSeconds)
 {
     Super::Tick(DeltaSeconds);
@@ -4,6 +4,8 @@
 #include "GameFramework/Actor.h"
 #include "Components/SceneComponent.h"
 #include "Engine/EngineTypes.h"
+#include "LoopResettable.h"
+#include "TimerManager.h"
 #include "PaintZone.generated.h"
 
 class UBoxComponent;
@@ -18,8 +20,12 @@ enum class EForceType : uint8
     Gravity UMETA(DisplayName = "Gravity")
 };
 
+/**
+ * Painted force zone. Zones are taken from the loop state pool, return to it when they expire and are
+ * all cleared when the loop resets.
+ */
 UCLASS()
-class APaintZone : public AActor
+class APaintZone : public AActor, public ILoopResettable
 {
     GENERATED_BODY()
 
@@ -35,6 +41,12 @@ public:
     /** Returns true if this zone is permanent. */
     bool IsPermanent() const { return bPermanent; }
 
+    //~ Begin ILoopResettable
+    virtual void RestoreLoopState() override {}
+    virtual void OnAcquiredFromPool() override;
+    virtual void OnReleasedToPool() override;
+    //~ End ILoopResettable
+
 protected:
     virtual void BeginPlay() override;
     virtual void Tick(float DeltaSeconds) override;
@@ -45,6 +57,9 @@ protected:
     /** Applies the configured force to every overlapping actor. */
     void ApplyForces(float DeltaSeconds);
 
+    /** Returns a temporary zone to the loop state pool once it has faded out. */
+    void Expire();
+
 protected:
     /** Root component */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -109,5 +124,8 @@ protected:
 private:
     /** Accumulated lifetime for fade/force management. */
     float ElapsedTime = 0.0f;
+
+    /** Fires Expire after LifeTime + FadeOutDuration for temporary zones. */
+    FTimerHandle ExpireTimerHandle;
 };
 
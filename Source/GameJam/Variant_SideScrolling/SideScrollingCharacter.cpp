@@ -11,6 +11,7 @@
 #include "InputAction.h"
 #include "Engine/World.h"
 #include "Gameplay/PaintZone.h"
+#include "LoopStateSubsystem.h"
 #include "GameFramework/PlayerController.h"
 #include "SideScrollingInteractable.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -273,7 +274,11 @@ void ASideScrollingCharacter::ShootPaint(EForceType ForceType, bool bMakePermane
         SpawnParams.Instigator = this;
         SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
-        APaintZone* PaintZone = World->SpawnActor<APaintZone>(PaintZoneClass, SpawnTransform, SpawnParams);
+        // Pooled so expired zones are reused and the loop reset can clear every zone painted during the loop.
+        ULoopStateSubsystem* LoopState = ULoopStateSubsystem::Get(World);
+        APaintZone* PaintZone = LoopState
+                ? LoopState->AcquireActor<APaintZone>(PaintZoneClass, SpawnTransform, SpawnParams)
+                : World->SpawnActor<APaintZone>(PaintZoneClass, SpawnTransform, SpawnParams);
         if (PaintZone)
         {
                 PaintZone->InitializePaintZone(ForceType, Hit.Normal, bMakePermanent);
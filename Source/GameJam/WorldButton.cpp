@@ -4,6 +4,7 @@
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "LoopStateSubsystem.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Sound/SoundBase.h"
@@ -13,11 +14,6 @@
 
 #include <limits>
 
-namespace
-{
-static const TArray<EWorldState> GAllWorldStates = {EWorldState::Light, EWorldState::Shadow, EWorldState::Chaos};
-}
-
 AWorldButton::AWorldButton()
 {
     PrimaryActorTick.bCanEverTick = false;
@@ -62,10 +58,19 @@ AWorldButton::AWorldButton()
     CurrentVisualWorld = EWorldState::Light;
 }
 
+void AWorldButton::OnConstruction(const FTransform& Transform)
+{
+    Super::OnConstruction(Transform);
+
+    BakeVisualStyles();
+}
+
 void AWorldButton::BeginPlay()
 {
     Super::BeginPlay();
 
+    BakeVisualStyles();
+
     if (ButtonMesh)
     {
         InitialButtonRelativeLocation = ButtonMesh->GetRelativeLocation();
@@ -201,6 +206,13 @@ void AWorldButton::ForceResetButton()
     ReceiveButtonReset();
 }
 
+void AWorldButton::RestoreLoopState()
+{
+    SetActorHiddenInGame(false);
+    SetActorEnableCollision(true);
+    ForceResetButton();
+}
+
 void AWorldButton::InitializeWorldBehaviorDefaults()
 {
     if (!WorldShiftBehavior)
@@ -210,22 +222,24 @@ void AWorldButton::InitializeWorldBehaviorDefaults()
 
     WorldShiftBehavior->SetTargetMesh(ButtonMesh);
 
-    if (WorldShiftBehavior->WorldBehaviors.Num() > 0)
+    if (WorldShiftBehavior->HasAnyWorldBehaviors())
     {
         return;
     }
 
-    for (EWorldState World : GAllWorldStates)
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
     {
+        const EWorldState World = static_cast<EWorldState>(WorldIndex);
         const bool bSolid = SolidWorlds.Contains(World);
         WorldShiftBehavior->WorldBehaviors.Add(World, bSolid ? EPlatformState::Solid : EPlatformState::Ghost);
     }
+
+    WorldShiftBehavior->NotifyWorldBehaviorsChanged();
 }
 
 void AWorldButton::RefreshButtonVisuals()
 {
-    const FWorldButtonVisualStyle Style = GetVisualStyleForWorld(CurrentVisualWorld);
-    ApplyVisualStyle(Style);
+    ApplyVisualStyle(GetVisualStyleForWorld(CurrentVisualWorld));
 }
 
 void AWorldButton::ApplyVisualStyle(const FWorldButtonVisualStyle& Style) const
@@ -244,14 +258,18 @@ void AWorldButton::ApplyVisualStyle(const FWorldButtonVisualStyle& Style) const
     }
 }
 
-FWorldButtonVisualStyle AWorldButton::GetVisualStyleForWorld(EWorldState World) const
+const FWorldButtonVisualStyle& AWorldButton::GetVisualStyleForWorld(EWorldState World) const
+{
+    return BakedVisualStyles[static_cast<int32>(World)];
+}
+
+void AWorldButton::BakeVisualStyles()
 {
-    if (const FWorldButtonVisualStyle* Override = WorldVisualStyles.Find(World))
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
     {
-        return *Override;
+        const FWorldButtonVisualStyle* Override = WorldVisualStyles.Find(static_cast<EWorldState>(WorldIndex));
+        BakedVisualStyles[WorldIndex] = Override ? *Override : DefaultVisualStyle;
     }
-
-    return DefaultVisualStyle;
 }
 
 bool AWorldButton::InternalPress(AActor* PressingActor)
@@ -266,6 +284,11 @@ bool AWorldButton::InternalPress(AActor* PressingActor)
     bIsPressed = true;
     bHasBeenPressedOnce = true;
 
+    if (ULoopStateSubsystem* LoopState = ULoopStateSubsystem::Get(GetWorld()))
+    {
+        LoopState->MarkDirty(this);
+    }
+
     RefreshButtonVisuals();
     HandlePressFeedback(PressingActor);
 
@@ -276,7 +299,9 @@ bool AWorldButton::InternalPress(AActor* PressingActor)
 
     if (bCanBePressedOnce && bDestroyAfterUse)
     {
-        Destroy();
+        // Hidden rather than destroyed so RestoreLoopState can bring it back.
+        SetActorHiddenInGame(true);
+        SetActorEnableCollision(false);
         return true;
     }
 
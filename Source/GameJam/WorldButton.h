@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "LoopResettable.h"
 #include "WorldShiftTypes.h"
 #include "TimerManager.h"
 #include "WorldButton.generated.h"
@@ -58,7 +59,7 @@ struct FWorldButtonVisualStyle
  * A world-reactive button that can trigger game logic when pressed by the player.
  */
 UCLASS()
-class GAMEJAM_API AWorldButton : public AActor
+class GAMEJAM_API AWorldButton : public AActor, public ILoopResettable
 {
     GENERATED_BODY()
 
@@ -89,6 +90,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Button")
     void ForceResetButton();
 
+    /** Restores the unpressed loop start state and revives a button used up by bDestroyAfterUse. */
+    virtual void RestoreLoopState() override;
+
     /** Registers an actor at runtime, ensuring duplicates are ignored and interface requirements enforced. */
     UFUNCTION(BlueprintCallable, Category = "Button|Linking")
     void RegisterLinkedTarget(AActor* NewTarget);
@@ -118,6 +122,7 @@ public:
     void ReceiveButtonReset();
 
 protected:
+    virtual void OnConstruction(const FTransform& Transform) override;
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
@@ -157,7 +162,7 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Button")
     bool bCanBePressedOnce;
 
-    /** When true, the button destroys itself after a successful one-time press. */
+    /** When true, the button disappears after a successful one-time press until the loop resets. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Button", meta = (EditCondition = "bCanBePressedOnce"))
     bool bDestroyAfterUse;
 
@@ -208,7 +213,8 @@ private:
     void InitializeWorldBehaviorDefaults();
     void RefreshButtonVisuals();
     void ApplyVisualStyle(const FWorldButtonVisualStyle& Style) const;
-    FWorldButtonVisualStyle GetVisualStyleForWorld(EWorldState World) const;
+    const FWorldButtonVisualStyle& GetVisualStyleForWorld(EWorldState World) const;
+    void BakeVisualStyles();
     bool InternalPress(AActor* PressingActor);
     void HandlePressFeedback(AActor* PressingActor);
     void NotifyLinkedTargets();
@@ -247,6 +253,9 @@ private:
     /** Cached world the button is currently visualizing. */
     EWorldState CurrentVisualWorld;
 
+    /** WorldVisualStyles flattened by world index, falling back to DefaultVisualStyle. */
+    FWorldButtonVisualStyle BakedVisualStyles[WorldStateCount];
+
     bool bIsPressed;
     bool bHasBeenPressedOnce;
     bool bIsInteractable;
@@ -3,6 +3,7 @@
 #include "ShiftPlatform.h"
 #include "WorldManager.h"
 #include "WorldShiftBehaviorComponent.h"
+#include "WorldShiftSubsystem.h"
 #include "Engine/CollisionProfile.h"
 #include "Components/StaticMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -43,31 +44,35 @@ void AWorldDoor::BeginPlay()
     }
 
     InitializeWorldBehaviors();
+    BakeSolidWorlds();
 
-    if (AWorldManager* Manager = AWorldManager::Get(GetWorld()))
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
     {
-        CachedWorldManager = Manager;
-        Manager->OnWorldShifted.AddDynamic(this, &AWorldDoor::HandleWorldShift);
-        HandleWorldShift(Manager->GetCurrentWorld());
+        Registry->OnWorldShiftedNative.AddUObject(this, &AWorldDoor::HandleWorldShift);
+        Registry->WhenWorldManagerReady(FOnWorldManagerReadyNative::FDelegate::CreateUObject(this, &AWorldDoor::HandleWorldManagerReady));
     }
-    else
+
+    if (!CachedWorldManager.IsValid())
     {
         SetDoorState(IsSolidInWorld(EWorldState::Light), EWorldState::Light);
     }
 }
 
+void AWorldDoor::HandleWorldManagerReady(AWorldManager* Manager)
+{
+    CachedWorldManager = Manager;
+    HandleWorldShift(Manager->GetCurrentWorld());
+}
+
 void AWorldDoor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    if (CachedWorldManager.IsValid())
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
     {
-        if (AWorldManager* Manager = CachedWorldManager.Get())
-        {
-            Manager->OnWorldShifted.RemoveDynamic(this, &AWorldDoor::HandleWorldShift);
-        }
-
-        CachedWorldManager.Reset();
+        Registry->OnWorldShiftedNative.RemoveAll(this);
     }
 
+    CachedWorldManager.Reset();
+
     Super::EndPlay(EndPlayReason);
 }
 
@@ -90,26 +95,35 @@ void AWorldDoor::SetDoorState(bool bShouldBeSolid, EWorldState CurrentWorld)
     bHasInitialized = true;
     bIsCurrentlySolid = bShouldBeSolid;
 
+    // With world collision channels the behavior component keeps the door body in the physics scene.
+    const bool bUseCollisionChannels = CachedWorldManager.IsValid() && CachedWorldManager->UsesWorldCollisionChannels();
+
     if (DoorMesh)
     {
         if (bShouldBeSolid)
         {
-            DoorMesh->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
-            DoorMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+            if (!bUseCollisionChannels)
+            {
+                DoorMesh->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+                DoorMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+            }
             DoorMesh->SetHiddenInGame(false);
             DoorMesh->SetVisibility(true, true);
         }
         else
         {
-            DoorMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-            DoorMesh->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+            if (!bUseCollisionChannels)
+            {
+                DoorMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+                DoorMesh->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+            }
 
             EPlatformState EffectiveState = EPlatformState::Ghost;
             if (WorldShiftBehavior)
             {
-                if (const EPlatformState* Behavior = WorldShiftBehavior->WorldBehaviors.Find(CurrentWorld))
+                if (WorldShiftBehavior->HasBehaviorForWorld(CurrentWorld))
                 {
-                    EffectiveState = *Behavior;
+                    EffectiveState = WorldShiftBehavior->GetBehaviorForWorld(CurrentWorld);
                 }
                 else
                 {
@@ -151,15 +165,25 @@ void AWorldDoor::PlayDoorAnimation(bool bOpening)
 
 bool AWorldDoor::IsSolidInWorld(EWorldState World) const
 {
-    if (WorldShiftBehavior)
+    return (SolidWorldMask & GetWorldBit(World)) != 0;
+}
+
+void AWorldDoor::BakeSolidWorlds()
+{
+    SolidWorldMask = 0;
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
     {
-        if (const EPlatformState* FoundState = WorldShiftBehavior->WorldBehaviors.Find(World))
+        const EWorldState World = static_cast<EWorldState>(WorldIndex);
+
+        const bool bSolid = (WorldShiftBehavior && WorldShiftBehavior->HasBehaviorForWorld(World))
+            ? (WorldShiftBehavior->GetWorldStateMasks().GetBlockingMask() & GetWorldBit(World)) != 0
+            : SolidInWorlds.Contains(World);
+
+        if (bSolid)
         {
-            return *FoundState == EPlatformState::Solid || *FoundState == EPlatformState::TimedSolid;
+            SolidWorldMask |= GetWorldBit(World);
         }
     }
-
-    return SolidInWorlds.Contains(World);
 }
 
 void AWorldDoor::InitializeWorldBehaviors()
@@ -171,15 +195,17 @@ void AWorldDoor::InitializeWorldBehaviors()
 
     WorldShiftBehavior->SetTargetMesh(DoorMesh);
 
-    if (WorldShiftBehavior->WorldBehaviors.Num() > 0)
+    if (WorldShiftBehavior->HasAnyWorldBehaviors())
     {
         return;
     }
 
-    const TArray<EWorldState> AllWorlds = {EWorldState::Light, EWorldState::Shadow, EWorldState::Chaos};
-    for (EWorldState World : AllWorlds)
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
     {
+        const EWorldState World = static_cast<EWorldState>(WorldIndex);
         const bool bSolid = SolidInWorlds.Contains(World);
         WorldShiftBehavior->WorldBehaviors.Add(World, bSolid ? EPlatformState::Solid : EPlatformState::Ghost);
     }
+
+    WorldShiftBehavior->NotifyWorldBehaviorsChanged();
 }
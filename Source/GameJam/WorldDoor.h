@@ -51,15 +51,23 @@ protected:
     bool bAnimateOnToggle;
 
 private:
-    UFUNCTION()
     void HandleWorldShift(EWorldState NewWorld);
 
+    /** Caches the world manager and applies its current world once it is registered. */
+    void HandleWorldManagerReady(AWorldManager* Manager);
+
     void SetDoorState(bool bShouldBeSolid, EWorldState CurrentWorld);
     void PlayDoorAnimation(bool bOpening);
 
     bool IsSolidInWorld(EWorldState World) const;
     void InitializeWorldBehaviors();
 
+    /** Resolves the per-world solidity table from the behavior component and SolidInWorlds. */
+    void BakeSolidWorlds();
+
+    /** Bit per world index where the door is solid, baked by BakeSolidWorlds. */
+    uint8 SolidWorldMask = 1;
+
     bool bIsCurrentlySolid;
     bool bHasInitialized;
     EWorldState CachedWorldState;
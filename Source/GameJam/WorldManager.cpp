@@ -1,6 +1,7 @@
 #include "WorldManager.h"
 
 #include "Components/PostProcessComponent.h"
+#include "Components/PrimitiveComponent.h"
 #include "Components/SceneComponent.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
@@ -8,19 +9,33 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/MovementComponent.h"
+#include "GameFramework/Pawn.h"
 #include "GameFramework/PlayerStart.h"
 #include "GameJamGameInstance.h"
 #include "Kismet/GameplayStatics.h"
+#include "LoopStateSubsystem.h"
 #include "Sound/SoundBase.h"
 #include "Sound/SoundSubmix.h"
 #include "Components/AudioComponent.h"
-#include "TimerManager.h"
+#include "Engine/LevelStreaming.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+#include "WorldPartition/DataLayer/DataLayerAsset.h"
+#include "WorldPartition/DataLayer/DataLayerManager.h"
+#include "WorldShiftStats.h"
+#include "WorldShiftSubsystem.h"
+#include "WorldShiftWorldList.h"
 
-TWeakObjectPtr<AWorldManager> AWorldManager::ActiveWorldManager = nullptr;
 
 AWorldManager::AWorldManager()
 {
-    PrimaryActorTick.bCanEverTick = false;
+    // Ticks only while the timed solid clock runs, post-process weights blend or a shift is pending; see RefreshTickEnabled.
+    // Ticking last lets every shift request made during the frame be committed together before rendering.
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
+    PrimaryActorTick.TickGroup = TG_PostUpdateWork;
 
     RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
 
@@ -31,51 +46,102 @@ AWorldManager::AWorldManager()
 
     StartingWorld = EWorldState::Light;
     CurrentWorld = StartingWorld;
+    PendingWorld = StartingWorld;
+    bHasPendingWorld = false;
     MusicFadeTime = 0.5f;
+    PostProcessBlendTime = 0.5f;
+    PostProcessTargetIndex = INDEX_NONE;
+    bPostProcessBlendActive = false;
+    bTimedSolidClockRunning = false;
+    ActiveMusicIndex = INDEX_NONE;
     CycleInterval = 5.0f;
     PreWarningTime = 1.0f;
     bGlobalTimedSolid = true;
+    bPreWarningActive = false;
+    TimedSolidEpoch = 0.0;
+    LastTimedSolidPhaseIndex = 0;
+    WorldIndexParameterName = TEXT("WorldIndex");
+    TimedSolidParameterName = TEXT("TimedSolidPhase");
+    PreWarningParameterName = TEXT("TimedSolidPreWarning");
+    bUseWorldCollisionChannels = false;
+    bUseWorldStreaming = false;
+    bUseWorldNavigation = false;
+    bPreloadBothNeighbors = false;
+    PredictedShiftDirection = 1;
+
+    UWorldShiftWorldList::BakeDefaultCycle(NextWorlds, PreviousWorlds);
+
+    // Matches the WorldNone..WorldAll object channels declared in DefaultEngine.ini.
+    for (int32 Mask = 0; Mask < FMath::Min(WorldMaskCount, MaxWorldMembershipChannels); ++Mask)
+    {
+        WorldMembershipChannels[Mask] = static_cast<ECollisionChannel>(ECC_GameTraceChannel2 + Mask);
+    }
 }
 
 AWorldManager* AWorldManager::Get(UWorld* World)
 {
-    if (ActiveWorldManager.IsValid())
+    const UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(World);
+    return Registry ? Registry->GetWorldManager() : nullptr;
+}
+
+void AWorldManager::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+
+    // Level actors are all initialized before any of them begins play, so registering here makes the
+    // manager visible to every BeginPlay. Actors that began play earlier are flushed in one batch.
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
     {
-        return ActiveWorldManager.Get();
+        Registry->SetWorldManager(this);
     }
+}
 
-    if (!World)
+void AWorldManager::BeginPlay()
+{
+    Super::BeginPlay();
+
+    CreateWorldPostProcessComponents();
+
+    if (WorldParameterCollection)
     {
-        return nullptr;
+        WorldParameterInstance = GetWorld()->GetParameterCollectionInstance(WorldParameterCollection);
     }
 
-    for (TActorIterator<AWorldManager> It(World); It; ++It)
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
     {
-        if (AWorldManager* Manager = *It)
-        {
-            ActiveWorldManager = Manager;
-            return Manager;
-        }
+        Registry->SetTimeSlicing(WorldShiftTimeSlicing);
+        Registry->SetGhostHintPool(GhostHintPool);
     }
 
-    return nullptr;
-}
+    if (UGhostReplaySubsystem* Ghosts = UGhostReplaySubsystem::Get(GetWorld()))
+    {
+        Ghosts->SetSettings(GhostReplay);
+        Ghosts->StartLoop();
+    }
 
-void AWorldManager::BeginPlay()
-{
-    Super::BeginPlay();
+    CreateWorldMusicComponents();
+
+    if (WorldList)
+    {
+        WorldList->BakeCycle(NextWorlds, PreviousWorlds);
+    }
+
+    if (bUseWorldStreaming)
+    {
+        ResolveWorldStreamingLevels();
+    }
 
-    ActiveWorldManager = this;
+    BindWorldNavigation();
 
-    if (PostProcessComponent)
+    if (UsesWorldCollisionChannels())
     {
-        DefaultPostProcessSettings = PostProcessComponent->Settings;
+        ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &AWorldManager::HandleActorSpawned));
     }
 
     CurrentWorld = StartingWorld;
 
     ApplyWorldFeedback(CurrentWorld);
-    OnWorldShifted.Broadcast(CurrentWorld);
+    BroadcastWorldShift(false);
 
     OnTimedSolidPhaseChanged.Broadcast(bGlobalTimedSolid);
     StartGlobalTimedSolidCycle();
@@ -85,38 +151,60 @@ void AWorldManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     StopGlobalTimedSolidCycle();
 
-    if (ActiveWorldManager.Get() == this)
+    UnbindWorldNavigation();
+
+    if (ActorSpawnedHandle.IsValid())
     {
-        ActiveWorldManager = nullptr;
+        GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        ActorSpawnedHandle.Reset();
     }
 
-    if (ActiveMusicComponent.IsValid())
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
     {
-        if (MusicFadeTime > 0.0f)
-        {
-            ActiveMusicComponent->FadeOut(MusicFadeTime, 0.0f);
-        }
-        else
-        {
-            ActiveMusicComponent->Stop();
-        }
-
-        ActiveMusicComponent.Reset();
+        Registry->ClearWorldManager(this);
     }
 
+    DestroyWorldMusicComponents();
+
     Super::EndPlay(EndPlayReason);
 }
 
 void AWorldManager::SetWorld(EWorldState NewWorld)
 {
-    if (CurrentWorld == NewWorld)
+    if (bHasPendingWorld)
     {
-        return;
+        INC_DWORD_STAT(STAT_WorldShiftCollapsedRequests);
     }
-    CurrentWorld = NewWorld;
 
-    ApplyWorldFeedback(CurrentWorld);
-    OnWorldShifted.Broadcast(CurrentWorld);
+    // Requesting the committed world cancels an earlier request from the same frame.
+    PendingWorld = NewWorld;
+    bHasPendingWorld = (NewWorld != CurrentWorld);
+    RefreshTickEnabled();
+}
+
+bool AWorldManager::CommitPendingWorld()
+{
+    if (!bHasPendingWorld)
+    {
+        return false;
+    }
+
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftSetWorld);
+
+    // Cleared before broadcasting so listeners that request another shift queue it for the next frame.
+    bHasPendingWorld = false;
+    const bool bWorldChanged = (PendingWorld != CurrentWorld);
+    if (bWorldChanged)
+    {
+        PredictedShiftDirection = (PendingWorld == GetPreviousWorld(CurrentWorld)) ? -1 : 1;
+        CurrentWorld = PendingWorld;
+
+        ApplyWorldFeedback(CurrentWorld);
+        BroadcastWorldShift();
+    }
+
+    RefreshTickEnabled();
+    return bWorldChanged;
 }
 
 void AWorldManager::CycleWorld(int32 Direction)
@@ -158,12 +246,21 @@ void AWorldManager::SetResetCheckpoint(AActor* NewCheckpoint)
 
 void AWorldManager::ResetWorld()
 {
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftResetWorld);
+
     UWorld* World = GetWorld();
     if (!World)
     {
         return;
     }
 
+    // Stored before the loop count advances so the recording keeps the index of the loop it was played in.
+    UGhostReplaySubsystem* Ghosts = UGhostReplaySubsystem::Get(World);
+    if (Ghosts)
+    {
+        Ghosts->FinishLoop();
+    }
+
     if (UGameJamGameInstance* GameInstance = Cast<UGameJamGameInstance>(World->GetGameInstance()))
     {
         GameInstance->HandleWorldReset();
@@ -172,12 +269,21 @@ void AWorldManager::ResetWorld()
 
     StopGlobalTimedSolidCycle();
 
+    // Rolls back only the actors that changed during the loop; no level reload is involved.
+    if (ULoopStateSubsystem* LoopState = ULoopStateSubsystem::Get(World))
+    {
+        LoopState->RestoreLoopStart();
+    }
+
     bGlobalTimedSolid = true;
+    bPreWarningActive = false;
     OnTimedSolidPhaseChanged.Broadcast(bGlobalTimedSolid);
 
+    // The reset applies right away and supersedes any shift requested earlier in the frame.
+    bHasPendingWorld = false;
     CurrentWorld = EWorldState::Light;
     ApplyWorldFeedback(CurrentWorld);
-    OnWorldShifted.Broadcast(CurrentWorld);
+    BroadcastWorldShift(false);
 
     APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(World, 0);
     if (PlayerPawn)
@@ -226,164 +332,537 @@ void AWorldManager::ResetWorld()
         }
     }
 
+    if (Ghosts)
+    {
+        Ghosts->StartLoop();
+    }
+
     StartGlobalTimedSolidCycle();
 }
 
+void AWorldManager::BroadcastWorldShift(bool bAllowTimeSlicing)
+{
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftBroadcast);
+
+    UpdateWorldStreaming();
+    UpdateWorldParameters();
+    UpdatePawnWorldCollision();
+    UpdateWorldNavigation();
+
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
+    {
+        Registry->ApplyWorld(CurrentWorld, bAllowTimeSlicing);
+    }
+
+    INC_DWORD_STAT(STAT_WorldShiftDelegateBroadcasts);
+    OnWorldShifted.Broadcast(CurrentWorld);
+}
+
+void AWorldManager::ResolveWorldStreamingLevels()
+{
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+    {
+        ResolvedWorldStreamingLevels[WorldIndex] = nullptr;
+
+        const TSoftObjectPtr<UWorld>* Level = WorldStreamingLevels.Find(static_cast<EWorldState>(WorldIndex));
+        if (!Level || Level->IsNull())
+        {
+            continue;
+        }
+
+        ResolvedWorldStreamingLevels[WorldIndex] = UGameplayStatics::GetStreamingLevel(this, FName(*Level->GetLongPackageName()));
+        if (!ResolvedWorldStreamingLevels[WorldIndex])
+        {
+            UE_LOG(LogTemp, Warning, TEXT("WorldManager '%s' could not find streaming level '%s'."), *GetName(), *Level->GetLongPackageName());
+        }
+    }
+}
+
+void AWorldManager::UpdateWorldStreaming()
+{
+    if (!bUseWorldStreaming)
+    {
+        return;
+    }
+
+    const EWorldState NextWorld = GetNextWorld(CurrentWorld);
+    const EWorldState PreviousWorld = GetPreviousWorld(CurrentWorld);
+    const EWorldState PredictedWorld = (PredictedShiftDirection < 0) ? PreviousWorld : NextWorld;
+    UDataLayerManager* DataLayerManager = UDataLayerManager::GetDataLayerManager(this);
+
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+    {
+        const EWorldState World = static_cast<EWorldState>(WorldIndex);
+        const bool bVisible = World == CurrentWorld;
+        const bool bLoaded = bVisible || World == PredictedWorld
+            || (bPreloadBothNeighbors && (World == NextWorld || World == PreviousWorld));
+
+        if (ULevelStreaming* StreamingLevel = ResolvedWorldStreamingLevels[WorldIndex])
+        {
+            // A world the prediction missed is loaded synchronously rather than leaving the player without its geometry.
+            const bool bMissed = bVisible && !StreamingLevel->IsLevelLoaded();
+            if (bMissed)
+            {
+                INC_DWORD_STAT(STAT_WorldShiftStreamingMisses);
+            }
+
+            StreamingLevel->bShouldBlockOnLoad = bMissed;
+            StreamingLevel->SetShouldBeLoaded(bLoaded);
+            StreamingLevel->SetShouldBeVisible(bVisible);
+        }
+
+        const TObjectPtr<UDataLayerAsset>* DataLayer = WorldDataLayers.Find(World);
+        if (DataLayerManager && DataLayer && *DataLayer)
+        {
+            const EDataLayerRuntimeState State = bVisible ? EDataLayerRuntimeState::Activated
+                : (bLoaded ? EDataLayerRuntimeState::Loaded : EDataLayerRuntimeState::Unloaded);
+            DataLayerManager->SetDataLayerRuntimeState(*DataLayer, State);
+        }
+    }
+}
+
+void AWorldManager::UpdateWorldNavigation()
+{
+    if (!bUseWorldNavigation)
+    {
+        return;
+    }
+
+    for (const FWorldShiftNavigationFilters& Filters : WorldNavigationFilters)
+    {
+        ApplyWorldNavigationFilter(Filters);
+    }
+}
+
+void AWorldManager::BindWorldNavigation()
+{
+    UWorld* World = GetWorld();
+    UNavigationSystemV1* NavSystem = World ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+    if (!bUseWorldNavigation || !NavSystem)
+    {
+        return;
+    }
+
+    for (TActorIterator<ANavigationData> It(World); It; ++It)
+    {
+        FindOrBakeNavigationFilters(**It);
+    }
+
+    NavSystem->OnNavDataRegisteredEvent.AddUniqueDynamic(this, &AWorldManager::HandleNavDataRegistered);
+}
+
+void AWorldManager::UnbindWorldNavigation()
+{
+    if (UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+    {
+        NavSystem->OnNavDataRegisteredEvent.RemoveDynamic(this, &AWorldManager::HandleNavDataRegistered);
+    }
+
+    WorldNavigationFilters.Reset();
+}
+
+void AWorldManager::HandleNavDataRegistered(ANavigationData* NavData)
+{
+    if (NavData)
+    {
+        ApplyWorldNavigationFilter(FindOrBakeNavigationFilters(*NavData));
+    }
+}
+
+FWorldShiftNavigationFilters& AWorldManager::FindOrBakeNavigationFilters(ANavigationData& NavData)
+{
+    FWorldShiftNavigationFilters* ExistingFilters = WorldNavigationFilters.FindByPredicate([&NavData](const FWorldShiftNavigationFilters& Entry)
+    {
+        return Entry.NavData.Get() == &NavData;
+    });
+
+    if (ExistingFilters)
+    {
+        return *ExistingFilters;
+    }
+
+    if (NavData.GetRuntimeGenerationMode() == ERuntimeGenerationType::Dynamic)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldManager '%s': navigation data '%s' uses dynamic generation, so shifts will still rebuild tiles."),
+            *GetName(), *NavData.GetName());
+    }
+
+    // Navigation data that went away leaves a stale row; drop those before adding a new one.
+    WorldNavigationFilters.RemoveAllSwap([](const FWorldShiftNavigationFilters& Entry) { return !Entry.NavData.IsValid(); });
+
+    FWorldShiftNavigationFilters& Filters = WorldNavigationFilters.AddDefaulted_GetRef();
+    Filters.Bake(NavData);
+    return Filters;
+}
+
+void AWorldManager::ApplyWorldNavigationFilter(const FWorldShiftNavigationFilters& Filters) const
+{
+    ANavigationData* NavData = Filters.NavData.Get();
+    if (!NavData)
+    {
+        return;
+    }
+
+    const int32 PhaseIndex = bGlobalTimedSolid ? 1 : 0;
+    if (const FSharedNavQueryFilter& Filter = Filters.Filters[static_cast<int32>(CurrentWorld)][PhaseIndex])
+    {
+        NavData->StoreQueryFilter(UWorldShiftNavigationQueryFilter::StaticClass(), Filter);
+    }
+}
+
 void AWorldManager::ApplyWorldFeedback(EWorldState NewWorld)
 {
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftApplyFeedback);
+
     ApplyPostProcessForWorld(NewWorld);
     ApplyAudioForWorld(NewWorld);
 }
 
 void AWorldManager::ApplyPostProcessForWorld(EWorldState NewWorld)
 {
-    if (!PostProcessComponent)
+    // Re-targeting the world already shown, e.g. on a loop reset, leaves the settled weights alone.
+    if (PostProcessTargetIndex == static_cast<int32>(NewWorld) && !bPostProcessBlendActive)
     {
         return;
     }
 
-    if (const FPostProcessSettings* Settings = WorldPostProcessSettings.Find(NewWorld))
-    {
-        PostProcessComponent->Settings = *Settings;
-    }
-    else
+    PostProcessTargetIndex = static_cast<int32>(NewWorld);
+
+    // The starting world is shown without a transition.
+    if (!HasActorBegunPlay() || PostProcessBlendTime <= 0.0f)
     {
-        PostProcessComponent->Settings = DefaultPostProcessSettings;
+        UpdatePostProcessBlend(0.0f);
+        return;
     }
 
-    PostProcessComponent->BlendWeight = 1.0f;
+    bPostProcessBlendActive = true;
+    RefreshTickEnabled();
 }
 
-void AWorldManager::ApplyAudioForWorld(EWorldState NewWorld)
+void AWorldManager::CreateWorldPostProcessComponents()
 {
-    if (ActiveMusicComponent.IsValid())
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
     {
-        if (MusicFadeTime > 0.0f)
+        const FPostProcessSettings* Settings = WorldPostProcessSettings.Find(static_cast<EWorldState>(WorldIndex));
+        if (!Settings)
         {
-            ActiveMusicComponent->FadeOut(MusicFadeTime, 0.0f);
+            continue;
         }
-        else
+
+        // Settings are copied once here; shifts only change blend weights.
+        UPostProcessComponent* WorldPostProcess = NewObject<UPostProcessComponent>(this);
+        WorldPostProcess->SetupAttachment(RootComponent);
+        WorldPostProcess->bUnbound = true;
+        WorldPostProcess->Priority = (PostProcessComponent ? PostProcessComponent->Priority : 0.0f) + 1.0f;
+        WorldPostProcess->BlendWeight = 0.0f;
+        WorldPostProcess->Settings = *Settings;
+        WorldPostProcess->RegisterComponent();
+
+        WorldPostProcessComponents[WorldIndex] = WorldPostProcess;
+    }
+}
+
+void AWorldManager::UpdatePostProcessBlend(float DeltaSeconds)
+{
+    const bool bSnap = !HasActorBegunPlay() || PostProcessBlendTime <= 0.0f;
+    const float Step = bSnap ? 1.0f : DeltaSeconds / PostProcessBlendTime;
+
+    bool bBlendFinished = true;
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+    {
+        UPostProcessComponent* WorldPostProcess = WorldPostProcessComponents[WorldIndex];
+        if (!WorldPostProcess)
         {
-            ActiveMusicComponent->Stop();
+            continue;
         }
 
-        ActiveMusicComponent.Reset();
+        const float TargetWeight = WorldIndex == PostProcessTargetIndex ? 1.0f : 0.0f;
+        WorldPostProcess->BlendWeight = FMath::FInterpConstantTo(WorldPostProcess->BlendWeight, TargetWeight, 1.0f, Step);
+        bBlendFinished &= WorldPostProcess->BlendWeight == TargetWeight;
     }
 
-    const TObjectPtr<USoundBase>* SongPtr = WorldSongs.Find(NewWorld);
-    USoundBase* WorldSong = SongPtr ? SongPtr->Get() : nullptr;
-    if (!WorldSong)
+    bPostProcessBlendActive = !bBlendFinished;
+    RefreshTickEnabled();
+}
+
+void AWorldManager::ApplyAudioForWorld(EWorldState NewWorld)
+{
+    const int32 NewMusicIndex = WorldMusicComponents[static_cast<int32>(NewWorld)] ? static_cast<int32>(NewWorld) : INDEX_NONE;
+    if (NewMusicIndex == ActiveMusicIndex)
     {
         return;
     }
 
-    UAudioComponent* NewMusicComponent = NewObject<UAudioComponent>(this);
-    if (NewMusicComponent)
+    if (ActiveMusicIndex != INDEX_NONE)
     {
-        NewMusicComponent->bAutoActivate = false;
-        NewMusicComponent->SetSound(WorldSong);
-        NewMusicComponent->RegisterComponent(); // make it part of the world
+        WorldMusicComponents[ActiveMusicIndex]->AdjustVolume(FMath::Max(0.0f, MusicFadeTime), 0.0f);
     }
 
-    if (!NewMusicComponent)
+    ActiveMusicIndex = NewMusicIndex;
+    if (ActiveMusicIndex == INDEX_NONE)
     {
         return;
     }
 
-    if (const TObjectPtr<USoundSubmix>* SubmixPtr = WorldSubmixes.Find(NewWorld))
-    {      
+    WorldMusicComponents[ActiveMusicIndex]->AdjustVolume(FMath::Max(0.0f, MusicFadeTime), 1.0f);
+}
+
+void AWorldManager::CreateWorldMusicComponents()
+{
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+    {
+        const EWorldState World = static_cast<EWorldState>(WorldIndex);
+        const TObjectPtr<USoundBase>* SongPtr = WorldSongs.Find(World);
+        USoundBase* WorldSong = SongPtr ? SongPtr->Get() : nullptr;
+        if (!WorldSong)
+        {
+            continue;
+        }
+
+        UAudioComponent* MusicComponent = NewObject<UAudioComponent>(this);
+        MusicComponent->bAutoActivate = false;
+        MusicComponent->bAllowSpatialization = false;
+        MusicComponent->SetSound(WorldSong);
+        MusicComponent->RegisterComponent(); // make it part of the world
+
+        if (const TObjectPtr<USoundSubmix>* SubmixPtr = WorldSubmixes.Find(World))
+        {
             if (USoundSubmix* Submix = SubmixPtr->Get())
             {
-                // Route the new audio component fully into the chosen submix
-                NewMusicComponent->SetSubmixSend(Submix, 1.0f);
-            }        
+                // Route the audio component fully into the chosen submix
+                MusicComponent->SetSubmixSend(Submix, 1.0f);
+            }
+        }
+
+        // Songs that do not loop would otherwise leave their world silent for the rest of the session.
+        MusicComponent->OnAudioFinishedNative.AddUObject(this, &AWorldManager::HandleMusicFinished);
+
+        // Start every song silently so a shift only ramps volume instead of allocating and starting a stream.
+        MusicComponent->FadeIn(0.0f, 0.0f);
+
+        WorldMusicComponents[WorldIndex] = MusicComponent;
+    }
+}
+
+void AWorldManager::DestroyWorldMusicComponents()
+{
+    for (TObjectPtr<UAudioComponent>& MusicComponent : WorldMusicComponents)
+    {
+        if (MusicComponent)
+        {
+            MusicComponent->OnAudioFinishedNative.RemoveAll(this);
+            MusicComponent->Stop();
+            MusicComponent->DestroyComponent();
+            MusicComponent = nullptr;
+        }
     }
 
-    ActiveMusicComponent = NewMusicComponent;
+    ActiveMusicIndex = INDEX_NONE;
+}
 
-    if (MusicFadeTime > 0.0f)
+void AWorldManager::HandleMusicFinished(UAudioComponent* AudioComponent)
+{
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
     {
-        NewMusicComponent->FadeIn(MusicFadeTime, 1.0f);
+        if (WorldMusicComponents[WorldIndex] == AudioComponent)
+        {
+            // A restart creates a new active sound, so the faded volume has to be applied again.
+            AudioComponent->FadeIn(0.0f, WorldIndex == ActiveMusicIndex ? 1.0f : 0.0f);
+            return;
+        }
     }
-    else
+}
+
+void AWorldManager::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    CommitPendingWorld();
+
+    if (bTimedSolidClockRunning)
+    {
+        UpdateTimedSolidClock();
+    }
+
+    if (bPostProcessBlendActive)
     {
-        NewMusicComponent->SetVolumeMultiplier(1.0f);
+        UpdatePostProcessBlend(DeltaSeconds);
     }
 }
 
-void AWorldManager::StartGlobalTimedSolidCycle()
+void AWorldManager::RefreshTickEnabled()
 {
-    StopGlobalTimedSolidCycle();
+    SetActorTickEnabled(bTimedSolidClockRunning || bPostProcessBlendActive || bHasPendingWorld);
+}
 
-    const float Interval = FMath::Max(0.01f, CycleInterval);
-    if (UWorld* World = GetWorld())
+void AWorldManager::UpdateTimedSolidClock()
+{
+    const UWorld* World = GetWorld();
+    if (!World)
     {
-        World->GetTimerManager().SetTimer(GlobalTimedSolidHandle, this, &AWorldManager::HandleGlobalTimedSolidToggle, Interval, true, Interval);
+        return;
+    }
 
-        if (PreWarningTime > 0.0f && PreWarningTime < Interval)
+    const double Now = World->GetTimeSeconds();
+    const int64 PhaseIndex = GetTimedSolidPhaseIndex(Now);
+    if (PhaseIndex != LastTimedSolidPhaseIndex)
+    {
+        // A hitch longer than a whole phase can skip an even number of flips; only report real changes.
+        const bool bShouldBeSolid = (PhaseIndex % 2) == 0;
+        LastTimedSolidPhaseIndex = PhaseIndex;
+
+        if (bShouldBeSolid != bGlobalTimedSolid)
+        {
+            HandleGlobalTimedSolidToggle();
+        }
+        else if (bPreWarningActive)
         {
-            const float Delay = Interval - PreWarningTime;
-            World->GetTimerManager().SetTimer(PreWarningHandle, this, &AWorldManager::BroadcastPreWarning, Delay, false);
+            bPreWarningActive = false;
+            UpdateWorldParameters();
         }
     }
+
+    const double Interval = FMath::Max(0.01f, CycleInterval);
+    const bool bInPreWarning = PreWarningTime > 0.0f && PreWarningTime < Interval
+        && GetTimeIntoTimedSolidPhase(Now) >= Interval - PreWarningTime;
+    if (bInPreWarning && !bPreWarningActive)
+    {
+        BroadcastPreWarning();
+    }
 }
 
-void AWorldManager::StopGlobalTimedSolidCycle()
+bool AWorldManager::IsTimedSolidAt(double WorldTime) const
 {
-    if (UWorld* World = GetWorld())
+    if (!bTimedSolidClockRunning)
     {
-        World->GetTimerManager().ClearTimer(GlobalTimedSolidHandle);
-        World->GetTimerManager().ClearTimer(PreWarningHandle);
+        return bGlobalTimedSolid;
     }
+
+    return (GetTimedSolidPhaseIndex(WorldTime) % 2) == 0;
+}
+
+float AWorldManager::TimeUntilNextPhase() const
+{
+    const UWorld* World = GetWorld();
+    if (!World || !bTimedSolidClockRunning)
+    {
+        return 0.0f;
+    }
+
+    const double Interval = FMath::Max(0.01f, CycleInterval);
+    return static_cast<float>(Interval - GetTimeIntoTimedSolidPhase(World->GetTimeSeconds()));
+}
+
+int64 AWorldManager::GetTimedSolidPhaseIndex(double WorldTime) const
+{
+    const double Interval = FMath::Max(0.01f, CycleInterval);
+    const double Elapsed = FMath::Max(0.0, WorldTime - TimedSolidEpoch);
+    return static_cast<int64>(FMath::FloorToDouble(Elapsed / Interval));
+}
+
+double AWorldManager::GetTimeIntoTimedSolidPhase(double WorldTime) const
+{
+    const double Interval = FMath::Max(0.01f, CycleInterval);
+    const double Elapsed = FMath::Max(0.0, WorldTime - TimedSolidEpoch);
+    return Elapsed - FMath::FloorToDouble(Elapsed / Interval) * Interval;
+}
+
+void AWorldManager::StartGlobalTimedSolidCycle()
+{
+    StopGlobalTimedSolidCycle();
+
+    if (const UWorld* World = GetWorld())
+    {
+        TimedSolidEpoch = World->GetTimeSeconds();
+        LastTimedSolidPhaseIndex = 0;
+        bTimedSolidClockRunning = true;
+        RefreshTickEnabled();
+    }
+}
+
+void AWorldManager::StopGlobalTimedSolidCycle()
+{
+    bTimedSolidClockRunning = false;
+    RefreshTickEnabled();
 }
 
 void AWorldManager::HandleGlobalTimedSolidToggle()
 {
     bGlobalTimedSolid = !bGlobalTimedSolid;
-    OnTimedSolidPhaseChanged.Broadcast(bGlobalTimedSolid);
+    bPreWarningActive = false;
+    UpdateWorldParameters();
+    UpdateWorldNavigation();
 
-    if (UWorld* World = GetWorld())
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
     {
-        World->GetTimerManager().ClearTimer(PreWarningHandle);
-
-        const float Interval = FMath::Max(0.01f, CycleInterval);
-        if (PreWarningTime > 0.0f && PreWarningTime < Interval)
-        {
-            const float Delay = Interval - PreWarningTime;
-            World->GetTimerManager().SetTimer(PreWarningHandle, this, &AWorldManager::BroadcastPreWarning, Delay, false);
-        }
+        Registry->DispatchTimedSolidPhaseChanged(bGlobalTimedSolid);
     }
+
+    INC_DWORD_STAT(STAT_WorldShiftDelegateBroadcasts);
+    OnTimedSolidPhaseChanged.Broadcast(bGlobalTimedSolid);
 }
 
 void AWorldManager::BroadcastPreWarning()
 {
+    bPreWarningActive = true;
+    UpdateWorldParameters();
+
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
+    {
+        Registry->DispatchTimedSolidPreWarning(!bGlobalTimedSolid);
+    }
+
+    INC_DWORD_STAT(STAT_WorldShiftDelegateBroadcasts);
     OnTimedSolidPreWarning.Broadcast(!bGlobalTimedSolid);
 }
 
-EWorldState AWorldManager::GetNextWorld(EWorldState InWorld)
+void AWorldManager::ApplyWorldCollisionResponses(UPrimitiveComponent* Primitive) const
+{
+    if (!UsesWorldCollisionChannels() || !Primitive)
+    {
+        return;
+    }
+
+    FCollisionResponseContainer Responses = Primitive->GetCollisionResponseToChannels();
+    const uint32 WorldBit = 1u << static_cast<uint32>(CurrentWorld);
+    for (int32 Mask = 0; Mask < WorldMaskCount; ++Mask)
+    {
+        Responses.SetResponse(WorldMembershipChannels[Mask], (Mask & WorldBit) ? ECR_Block : ECR_Ignore);
+    }
+
+    Primitive->SetCollisionResponseToChannels(Responses);
+}
+
+void AWorldManager::UpdatePawnWorldCollision() const
 {
-    switch (InWorld)
+    if (!UsesWorldCollisionChannels())
     {
-    case EWorldState::Light:
-        return EWorldState::Shadow;
-    case EWorldState::Shadow:
-        return EWorldState::Chaos;
-    case EWorldState::Chaos:
-    default:
-        return EWorldState::Light;
+        return;
+    }
+
+    // AI and NPC pawns walk on shiftables too, so every pawn follows the current world, not only the player.
+    for (TActorIterator<APawn> It(GetWorld()); It; ++It)
+    {
+        ApplyWorldCollisionResponses(Cast<UPrimitiveComponent>(It->GetRootComponent()));
+    }
+}
+
+void AWorldManager::HandleActorSpawned(AActor* SpawnedActor)
+{
+    if (const APawn* Pawn = Cast<APawn>(SpawnedActor))
+    {
+        ApplyWorldCollisionResponses(Cast<UPrimitiveComponent>(Pawn->GetRootComponent()));
     }
 }
 
-EWorldState AWorldManager::GetPreviousWorld(EWorldState InWorld)
+void AWorldManager::UpdateWorldParameters()
 {
-    switch (InWorld)
+    if (!WorldParameterInstance)
     {
-    case EWorldState::Light:
-        return EWorldState::Chaos;
-    case EWorldState::Shadow:
-        return EWorldState::Light;
-    case EWorldState::Chaos:
-    default:
-        return EWorldState::Shadow;
+        return;
     }
+
+    WorldParameterInstance->SetScalarParameterValue(WorldIndexParameterName, static_cast<float>(CurrentWorld));
+    WorldParameterInstance->SetScalarParameterValue(TimedSolidParameterName, bGlobalTimedSolid ? 1.0f : 0.0f);
+    WorldParameterInstance->SetScalarParameterValue(PreWarningParameterName, bPreWarningActive ? 1.0f : 0.0f);
 }
@@ -4,14 +4,22 @@
 #include "Engine/PostProcessVolume.h"
 #include "GameFramework/Actor.h"
 #include "WorldShiftTypes.h"
+#include "WorldShiftNavigation.h"
+#include "WorldShiftSubsystem.h"
+#include "GhostReplaySubsystem.h"
 #include "WorldManager.generated.h"
 
 
 class UAudioComponent;
+class UDataLayerAsset;
+class ULevelStreaming;
+class UPrimitiveComponent;
+class UMaterialParameterCollection;
+class UMaterialParameterCollectionInstance;
 class UPostProcessComponent;
 class USoundBase;
 class USoundSubmix;
-struct FTimerHandle;
+class UWorldShiftWorldList;
 
 /** Enum describing the three available world states. */
 
@@ -22,6 +30,10 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTimedSolidPreWarning, bool, bWill
 /**
  * Central manager responsible for tracking the active world and applying
  * audiovisual feedback when the world changes.
+ *
+ * Shift requests are queued and committed once per frame from Tick, which runs in TG_PostUpdateWork
+ * after input, timers and gameplay ticks. GetCurrentWorld is the committed world for the whole frame,
+ * and the last request of a frame wins.
  */
 UCLASS(BlueprintType)
 class GAMEJAM_API AWorldManager : public AActor
@@ -31,30 +43,50 @@ class GAMEJAM_API AWorldManager : public AActor
 public:
     AWorldManager();
 
-    /** Returns the globally accessible world manager for the provided world. */
+    virtual void Tick(float DeltaSeconds) override;
+
+    /** Returns the world manager of the provided world, as registered with its UWorldShiftSubsystem. */
     static AWorldManager* Get(UWorld* World);
 
-    /** Returns the currently active world. */
+    /** Returns the world committed for this frame. Requests made this frame are not visible until the commit. */
     UFUNCTION(BlueprintPure, Category = "World Shift")
     EWorldState GetCurrentWorld() const { return CurrentWorld; }
 
-    /** Sets the current world to the supplied value. */
+    /** Returns the world that will be active after the next commit. */
+    UFUNCTION(BlueprintPure, Category = "World Shift")
+    EWorldState GetRequestedWorld() const { return bHasPendingWorld ? PendingWorld : CurrentWorld; }
+
+    /** Requests the supplied world. It is applied at the end of the frame, replacing earlier requests of the same frame. */
     UFUNCTION(BlueprintCallable, Category = "World Shift")
     void SetWorld(EWorldState NewWorld);
 
-    /** Cycles forward or backward depending on the provided direction. */
+    /**
+     * Requests the world Direction steps away from the committed world. Repeated requests in one frame
+     * are relative to the same committed world, so they collapse into one shift.
+     */
     UFUNCTION(BlueprintCallable, Category = "World Shift")
     void CycleWorld(int32 Direction);
 
-    /** Convenience wrapper that cycles forward (Light → Shadow → Dream). */
+    /** Applies the pending shift request right away. Returns whether the world changed. */
+    bool CommitPendingWorld();
+
+    /** Returns the world after the supplied one in the WorldList cycle order. */
+    UFUNCTION(BlueprintPure, Category = "World Shift")
+    EWorldState GetNextWorld(EWorldState InWorld) const { return NextWorlds[static_cast<int32>(InWorld) % WorldStateCount]; }
+
+    /** Returns the world before the supplied one in the WorldList cycle order. */
+    UFUNCTION(BlueprintPure, Category = "World Shift")
+    EWorldState GetPreviousWorld(EWorldState InWorld) const { return PreviousWorlds[static_cast<int32>(InWorld) % WorldStateCount]; }
+
+    /** Convenience wrapper that cycles forward through the WorldList. */
     UFUNCTION(BlueprintCallable, Category = "World Shift")
     void ShiftToNextWorld();
 
-    /** Convenience wrapper that cycles backward (Dream → Shadow → Light). */
+    /** Convenience wrapper that cycles backward through the WorldList. */
     UFUNCTION(BlueprintCallable, Category = "World Shift")
     void ShiftToPreviousWorld();
 
-    /** Restores the active world and player state to the solid world baseline. */
+    /** Restores the active world, loop-resettable actors and player state to the loop start baseline. */
     UFUNCTION(BlueprintCallable, Category = "World Shift|Reset")
     void ResetWorld();
 
@@ -62,7 +94,7 @@ public:
     UFUNCTION(BlueprintCallable, Category = "World Shift|Reset")
     void SetResetCheckpoint(AActor* NewCheckpoint);
 
-    /** Broadcast when the world changes. */
+    /** Broadcast when the world changes. Native code should listen on UWorldShiftSubsystem instead. */
     UPROPERTY(BlueprintAssignable, Category = "World Shift")
     FOnWorldShifted OnWorldShifted;
 
@@ -78,58 +110,248 @@ public:
     UFUNCTION(BlueprintPure, Category = "World Shift|Timed Solid")
     bool IsGlobalTimedSolidSolid() const { return bGlobalTimedSolid; }
 
+    /** Returns whether the pre-warning window of the current timed solid phase is active. */
+    UFUNCTION(BlueprintPure, Category = "World Shift|Timed Solid")
+    bool IsTimedSolidPreWarningActive() const { return bPreWarningActive; }
+
+    /** Predicts whether the global timed solid state is solid at the supplied world time (UWorld::GetTimeSeconds). */
+    UFUNCTION(BlueprintPure, Category = "World Shift|Timed Solid")
+    bool IsTimedSolidAt(double WorldTime) const;
+
+    /** Returns the seconds left until the global timed solid phase flips. */
+    UFUNCTION(BlueprintPure, Category = "World Shift|Timed Solid")
+    float TimeUntilNextPhase() const;
+
+    /** Returns whether world membership is expressed through object channels instead of collision toggles. */
+    UFUNCTION(BlueprintPure, Category = "World Shift|Collision")
+    bool UsesWorldCollisionChannels() const { return bUseWorldCollisionChannels && WorldMaskCount <= MaxWorldMembershipChannels; }
+
+    /** Returns the object channel for shiftables that are solid in exactly the worlds of the supplied bitmask. */
+    ECollisionChannel GetWorldMembershipChannel(uint8 SolidWorldMask) const { return WorldMembershipChannels[SolidWorldMask & (WorldMaskCount - 1)]; }
+
+    /**
+     * Makes the supplied primitive block only the membership channels that include the current world. Every pawn's
+     * root primitive is kept up to date automatically; simulated physics bodies are not, so they keep resting on
+     * hidden shiftables and levels that rely on them should leave bUseWorldCollisionChannels off.
+     */
+    UFUNCTION(BlueprintCallable, Category = "World Shift|Collision")
+    void ApplyWorldCollisionResponses(UPrimitiveComponent* Primitive) const;
+
 
 
 protected:
+    virtual void PostInitializeComponents() override;
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+    /**
+     * Applies the current world to the world shift registry, then notifies Blueprint listeners.
+     * Passing false forces every shiftable to update in this frame regardless of time slicing.
+     */
+    void BroadcastWorldShift(bool bAllowTimeSlicing = true);
+
     /** Applies all audiovisual feedback related to the supplied world. */
     void ApplyWorldFeedback(EWorldState NewWorld);
 
-    /** Applies post-process settings for the supplied world. */
+    /** Updates the responses of every pawn to the world membership channels. */
+    void UpdatePawnWorldCollision() const;
+
+    /** Gives pawns spawned after the last shift the current world's membership responses. */
+    void HandleActorSpawned(AActor* SpawnedActor);
+
+    /** Writes the active world and timed solid phase to the world parameter collection. */
+    void UpdateWorldParameters();
+
+    /** Starts blending the post-process components towards the supplied world. */
     void ApplyPostProcessForWorld(EWorldState NewWorld);
 
-    /** Applies audio snapshot for the supplied world. */
+    /** Creates one unbound post-process component per configured world, layered over PostProcessComponent. */
+    void CreateWorldPostProcessComponents();
+
+    /** Moves the world post-process blend weights towards their targets. */
+    void UpdatePostProcessBlend(float DeltaSeconds);
+
+    /** Advances the timed solid clock and broadcasts phase changes and pre-warnings. */
+    void UpdateTimedSolidClock();
+
+    /** Ticks only while the timed solid clock runs, a post-process blend is in progress or a shift request is pending. */
+    void RefreshTickEnabled();
+
+    /** Finds the streaming levels named in WorldStreamingLevels. */
+    void ResolveWorldStreamingLevels();
+
+    /** Shows the active world's exclusive content, keeps the predicted next world loaded and unloads the rest. */
+    void UpdateWorldStreaming();
+
+    /** Points every navigation data's world shift query filter at the one baked for the active world and phase. */
+    void UpdateWorldNavigation();
+
+    /** Bakes the per-world filters of every navigation data present and binds to later registrations. */
+    void BindWorldNavigation();
+
+    void UnbindWorldNavigation();
+
+    /** Bakes the filters of navigation data registered after BeginPlay and applies the active world's filter. */
+    UFUNCTION()
+    void HandleNavDataRegistered(ANavigationData* NavData);
+
+    /** Bakes the filters for the supplied navigation data unless they already exist. */
+    FWorldShiftNavigationFilters& FindOrBakeNavigationFilters(ANavigationData& NavData);
+
+    /** Stores the active world and phase's filter on the supplied navigation data. */
+    void ApplyWorldNavigationFilter(const FWorldShiftNavigationFilters& Filters) const;
+
+    /** Crossfades the pooled music components to the supplied world's song. */
     void ApplyAudioForWorld(EWorldState NewWorld);
 
+    /** Creates one silent, already playing music component per configured world song. */
+    void CreateWorldMusicComponents();
+
+    /** Stops and releases the pooled music components. */
+    void DestroyWorldMusicComponents();
+
+    /** Restarts a pooled music component whose song ended, at the volume its world currently has. */
+    void HandleMusicFinished(UAudioComponent* AudioComponent);
+
     /** Handles the global timed solid toggle. */
     void HandleGlobalTimedSolidToggle();
 
     /** Broadcasts the upcoming timed solid phase. */
     void BroadcastPreWarning();
 
-    /** Starts the global timed solid cycle timers. */
+    /** Restarts the global timed solid clock from the current world time. */
     void StartGlobalTimedSolidCycle();
 
-    /** Stops the global timed solid cycle timers. */
+    /** Stops evaluating the global timed solid clock. */
     void StopGlobalTimedSolidCycle();
 
+    /** Returns the index of the timed solid phase containing the supplied world time. Even phases are solid. */
+    int64 GetTimedSolidPhaseIndex(double WorldTime) const;
 
-private:
-    static TWeakObjectPtr<AWorldManager> ActiveWorldManager;
+    /** Returns the seconds already spent in the phase containing the supplied world time. */
+    double GetTimeIntoTimedSolidPhase(double WorldTime) const;
 
-    /** Ordered helper used for cycling between worlds. */
-    static EWorldState GetNextWorld(EWorldState InWorld);
-    static EWorldState GetPreviousWorld(EWorldState InWorld);
 
-    /** Component used to apply camera wide post-process effects. */
+private:
+    /** Object channels available for world membership. Channel mode needs one per world bitmask. */
+    static constexpr int32 MaxWorldMembershipChannels = ECC_GameTraceChannel18 - ECC_GameTraceChannel2 + 1;
+
+    /** Base camera wide post-process effects. World settings are blended over it. */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "World Shift|Visual", meta = (AllowPrivateAccess = "true"))
     TObjectPtr<UPostProcessComponent> PostProcessComponent;
 
-    /** Configurable post-process settings per world. */
+    /** Configurable post-process settings per world. Properties left unchecked fall back to PostProcessComponent. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Visual", meta = (AllowPrivateAccess = "true"))
     TMap<EWorldState, FPostProcessSettings> WorldPostProcessSettings;
 
-    /** Copy of the initial post process settings used as fallback. */
-    UPROPERTY(VisibleInstanceOnly, Category = "World Shift|Visual", meta = (AllowPrivateAccess = "true"))
-    FPostProcessSettings DefaultPostProcessSettings;
+    /** Seconds to blend between world post-process settings. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Visual", meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+    float PostProcessBlendTime;
+
+    /** Post-process component per world, created in BeginPlay from WorldPostProcessSettings. */
+    UPROPERTY(Transient)
+    TObjectPtr<UPostProcessComponent> WorldPostProcessComponents[WorldStateCount];
+
+    /** World whose post-process component is blending towards full weight. */
+    int32 PostProcessTargetIndex;
+
+    bool bPostProcessBlendActive;
+
+    /** Collection read by world-aware materials. Lets platforms change look without per-mesh material swaps. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Visual", meta = (AllowPrivateAccess = "true"))
+    TObjectPtr<UMaterialParameterCollection> WorldParameterCollection;
+
+    /** Scalar parameter receiving the active world index. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Visual", meta = (AllowPrivateAccess = "true"))
+    FName WorldIndexParameterName;
+
+    /** Scalar parameter receiving 1 while the timed solid phase is solid, 0 otherwise. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Visual", meta = (AllowPrivateAccess = "true"))
+    FName TimedSolidParameterName;
+
+    /** Scalar parameter receiving 1 during the timed solid pre-warning window, 0 otherwise. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Visual", meta = (AllowPrivateAccess = "true"))
+    FName PreWarningParameterName;
+
+    /** Runtime instance of WorldParameterCollection for this world. */
+    UPROPERTY(Transient)
+    TObjectPtr<UMaterialParameterCollectionInstance> WorldParameterInstance;
+
+    /**
+     * When enabled, shiftable bodies stay in the physics scene and use an object channel describing the worlds
+     * they are solid in. A shift changes every pawn's responses to those channels, and each shiftable only swaps
+     * its Visibility and Camera responses when its own solidity changes. Simulated physics bodies are not filtered.
+     * Needs one object channel per world bitmask, so it is ignored when there are more than four worlds.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Collision", meta = (AllowPrivateAccess = "true"))
+    bool bUseWorldCollisionChannels;
+
+    /** Object channel per solid-world bitmask (bit per EWorldState value). */
+    UPROPERTY(EditAnywhere, Category = "World Shift|Collision", meta = (AllowPrivateAccess = "true", EditCondition = "bUseWorldCollisionChannels"))
+    TEnumAsByte<ECollisionChannel> WorldMembershipChannels[WorldMaskCount];
+
+    /** Keeps pawns spawned between shifts on the current world's membership responses. */
+    FDelegateHandle ActorSpawnedHandle;
+
+    /** Spreads shiftables far from the player over several frames after a shift. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Performance", meta = (AllowPrivateAccess = "true"))
+    FWorldShiftTimeSlicing WorldShiftTimeSlicing;
+
+    /** Shared ghost hint meshes assigned to the platforms nearest to the player. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Performance", meta = (AllowPrivateAccess = "true"))
+    FWorldShiftGhostHintPool GhostHintPool;
+
+    /** Recording of each loop's player trajectory and replay of earlier loops as ghosts. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Reset", meta = (AllowPrivateAccess = "true"))
+    FGhostReplaySettings GhostReplay;
+
+    /**
+     * Streams world-exclusive content instead of keeping every world resident. The active world's sublevel or
+     * data layer is visible, the world predicted from the last shift direction is loaded but hidden, and the
+     * remaining world is unloaded. A shift the prediction missed blocks until the world has loaded.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Streaming", meta = (AllowPrivateAccess = "true"))
+    bool bUseWorldStreaming;
+
+    /** Blueprint-streamed sublevel holding each world's exclusive content. Must be listed in the persistent level's Levels. */
+    UPROPERTY(EditAnywhere, Category = "World Shift|Streaming", meta = (AllowPrivateAccess = "true", EditCondition = "bUseWorldStreaming"))
+    TMap<EWorldState, TSoftObjectPtr<UWorld>> WorldStreamingLevels;
+
+    /** World Partition runtime data layer holding each world's exclusive content. */
+    UPROPERTY(EditAnywhere, Category = "World Shift|Streaming", meta = (AllowPrivateAccess = "true", EditCondition = "bUseWorldStreaming"))
+    TMap<EWorldState, TObjectPtr<UDataLayerAsset>> WorldDataLayers;
+
+    /** Keeps both neighboring worlds loaded rather than only the predicted one. Uses more memory but never misses. */
+    UPROPERTY(EditAnywhere, Category = "World Shift|Streaming", meta = (AllowPrivateAccess = "true", EditCondition = "bUseWorldStreaming"))
+    bool bPreloadBothNeighbors;
+
+    /** Streaming level per world, resolved in BeginPlay from WorldStreamingLevels. */
+    UPROPERTY(Transient)
+    TObjectPtr<ULevelStreaming> ResolvedWorldStreamingLevels[WorldStateCount];
+
+    /** Direction of the last shift in GetNextWorld order (1 forward, -1 backward), used to predict the next one. */
+    int32 PredictedShiftDirection;
+
+    /**
+     * Swaps prebaked per-world query filters on shift instead of rebuilding navmesh tiles. Shiftables are marked
+     * with UNavArea_WorldShift areas in a navmesh baked with all of them present; AI controllers must use
+     * UWorldShiftNavigationQueryFilter. Set the navmesh's Runtime Generation to Static or Dynamic Modifiers Only
+     * so collision toggles on shift do not dirty tiles.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Navigation", meta = (AllowPrivateAccess = "true"))
+    bool bUseWorldNavigation;
+
+    /** Filters baked per navigation data when it registers or on BeginPlay. Shifts only iterate this list. */
+    TArray<FWorldShiftNavigationFilters> WorldNavigationFilters;
 
     /** Per-world output submix routing. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Audio", meta = (AllowPrivateAccess = "true"))
     TMap<EWorldState, TObjectPtr<USoundSubmix>> WorldSubmixes;
 
-    /** Per-world music assets. */
+    /**
+     * Per-world music assets. Each song gets a persistent audio component that keeps playing silently while
+     * its world is inactive; set the sound's virtualization mode to Play When Silent to keep its position.
+     */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Audio", meta = (AllowPrivateAccess = "true"))
     TMap<EWorldState, TObjectPtr<USoundBase>> WorldSongs;
 
@@ -137,6 +359,16 @@ private:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Audio", meta = (AllowPrivateAccess = "true"))
     float MusicFadeTime;
 
+    /** Worlds cycled through by CycleWorld and their order. Cycles through every world when unset. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift", meta = (AllowPrivateAccess = "true"))
+    TObjectPtr<UWorldShiftWorldList> WorldList;
+
+    /** Next world per world index, baked from WorldList. */
+    EWorldState NextWorlds[WorldStateCount];
+
+    /** Previous world per world index, baked from WorldList. */
+    EWorldState PreviousWorlds[WorldStateCount];
+
     /** Starting world configured in the editor. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift", meta = (AllowPrivateAccess = "true"))
     EWorldState StartingWorld;
@@ -149,13 +381,22 @@ private:
     UPROPERTY(VisibleInstanceOnly, Category = "World Shift|Reset", meta = (AllowPrivateAccess = "true"))
     TWeakObjectPtr<AActor> ActiveResetCheckpoint;
 
-    /** Currently active music component. */
-    TWeakObjectPtr<UAudioComponent> ActiveMusicComponent;
+    /** Pooled music component per world, created in BeginPlay from WorldSongs. */
+    UPROPERTY(Transient)
+    TObjectPtr<UAudioComponent> WorldMusicComponents[WorldStateCount];
+
+    /** World whose music component is currently faded in, or INDEX_NONE. */
+    int32 ActiveMusicIndex;
 
     /** Currently active world. */
     UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "World Shift", meta = (AllowPrivateAccess = "true"))
     EWorldState CurrentWorld;
 
+    /** World requested through SetWorld, committed on the next Tick. Only valid while bHasPendingWorld is set. */
+    EWorldState PendingWorld;
+
+    bool bHasPendingWorld;
+
     /** Duration of each timed solid phase. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Timed Solid", meta = (AllowPrivateAccess = "true", ClampMin = "0.01"))
     float CycleInterval;
@@ -168,11 +409,16 @@ private:
     UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "World Shift|Timed Solid", meta = (AllowPrivateAccess = "true"))
     bool bGlobalTimedSolid;
 
-    /** Handle for the repeating global timed solid timer. */
-    FTimerHandle GlobalTimedSolidHandle;
+    /** Tracks whether the pre-warning window of the current timed solid phase is active. */
+    bool bPreWarningActive;
+
+    bool bTimedSolidClockRunning;
+
+    /** World time at which the current timed solid cycle started in its solid phase. */
+    double TimedSolidEpoch;
 
-    /** Handle for the pre-warning timer. */
-    FTimerHandle PreWarningHandle;
+    /** Phase index last reported through OnTimedSolidPhaseChanged. */
+    int64 LastTimedSolidPhaseIndex;
 
 };
 
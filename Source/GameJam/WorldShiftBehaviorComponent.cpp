@@ -4,6 +4,9 @@
 #include "Materials/MaterialInterface.h"
 #include "ShiftPlatform.h"
 #include "WorldManager.h"
+#include "WorldShiftProfile.h"
+#include "WorldShiftStats.h"
+#include "WorldShiftSubsystem.h"
 
 UWorldShiftBehaviorComponent::UWorldShiftBehaviorComponent()
 {
@@ -11,16 +14,21 @@ UWorldShiftBehaviorComponent::UWorldShiftBehaviorComponent()
 
     CurrentWorld = EWorldState::Light;
     CurrentState = EPlatformState::Solid;
+
+    BakeWorldTables();
 }
 
 void UWorldShiftBehaviorComponent::SetTargetMesh(UStaticMeshComponent* InMesh)
 {
     TargetMesh = InMesh;
+    bLookApplied = false;
+    AppliedMaterial = nullptr;
 }
 
 void UWorldShiftBehaviorComponent::SetGhostHintMesh(UStaticMeshComponent* InMesh)
 {
     GhostHintMesh = InMesh;
+    AppliedHintWorldIndex = MAX_int8;
 
     if (GhostHintMesh)
     {
@@ -33,57 +41,58 @@ void UWorldShiftBehaviorComponent::SetGhostHintMesh(UStaticMeshComponent* InMesh
 void UWorldShiftBehaviorComponent::ResetWorldBehaviors()
 {
     WorldBehaviors.Reset();
+    BakeWorldTables();
 }
 
 void UWorldShiftBehaviorComponent::EnsureWorldBehaviorsFromPrefab(EPlatformPrefabType PrefabType)
 {
-    if (WorldBehaviors.Num() > 0)
+    // An authored instance map replaces the prefab entirely, as it always has: worlds it leaves out stay Solid.
+    PrefabProfile = WorldBehaviors.Num() > 0 ? nullptr : UWorldShiftProfile::GetPrefabProfile(PrefabType);
+
+    RemoveRedundantOverrides();
+    BakeWorldTables();
+}
+
+void UWorldShiftBehaviorComponent::RemoveRedundantOverrides()
+{
+    const UWorldShiftProfile* ActiveProfile = GetActiveProfile();
+    if (!ActiveProfile)
     {
         return;
     }
 
-    auto Configure = [this](EPlatformState LightState, EPlatformState ShadowState, EPlatformState ChaosState)
+    for (auto It = WorldBehaviors.CreateIterator(); It; ++It)
+    {
+        const EPlatformState* ProfileState = ActiveProfile->WorldBehaviors.Find(It->Key);
+        if (ProfileState && *ProfileState == It->Value)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    auto RemoveMatchingMaterials = [](TMap<EWorldState, TObjectPtr<UMaterialInterface>>& Overrides, const TMap<EWorldState, TObjectPtr<UMaterialInterface>>& ProfileMaterials)
     {
-        WorldBehaviors.Add(EWorldState::Light, LightState);
-        WorldBehaviors.Add(EWorldState::Shadow, ShadowState);
-        WorldBehaviors.Add(EWorldState::Chaos, ChaosState);
+        for (auto It = Overrides.CreateIterator(); It; ++It)
+        {
+            const TObjectPtr<UMaterialInterface>* ProfileMaterial = ProfileMaterials.Find(It->Key);
+            if (ProfileMaterial && *ProfileMaterial == It->Value)
+            {
+                It.RemoveCurrent();
+            }
+        }
+
+        if (Overrides.Num() == 0)
+        {
+            Overrides.Empty();
+        }
     };
 
-    switch (PrefabType)
+    RemoveMatchingMaterials(GhostMaterials, ActiveProfile->GhostMaterials);
+    RemoveMatchingMaterials(GhostHintMaterials, ActiveProfile->GhostHintMaterials);
+
+    if (WorldBehaviors.Num() == 0)
     {
-    case EPlatformPrefabType::LightBridge:
-        Configure(EPlatformState::Solid, EPlatformState::Hidden, EPlatformState::Hidden);
-        break;
-    case EPlatformPrefabType::LightToShadow:
-        Configure(EPlatformState::Solid, EPlatformState::Ghost, EPlatformState::Hidden);
-        break;
-    case EPlatformPrefabType::ShadowBridge:
-        Configure(EPlatformState::Hidden, EPlatformState::Solid, EPlatformState::Hidden);
-        break;
-    case EPlatformPrefabType::ShadowIllusion:
-        Configure(EPlatformState::Solid, EPlatformState::Ghost, EPlatformState::Solid);
-        break;
-    case EPlatformPrefabType::ChaosFlicker:
-        Configure(EPlatformState::Hidden, EPlatformState::Hidden, EPlatformState::TimedSolid);
-        break;
-    case EPlatformPrefabType::ChaosTrap:
-        Configure(EPlatformState::Solid, EPlatformState::Solid, EPlatformState::Ghost);
-        break;
-    case EPlatformPrefabType::ChaosBridge:
-        Configure(EPlatformState::Hidden, EPlatformState::Hidden, EPlatformState::Solid);
-        break;
-    case EPlatformPrefabType::ShiftChain:
-        Configure(EPlatformState::Solid, EPlatformState::Solid, EPlatformState::TimedSolid);
-        break;
-    case EPlatformPrefabType::HiddenSurprise:
-        Configure(EPlatformState::Hidden, EPlatformState::Ghost, EPlatformState::Solid);
-        break;
-    case EPlatformPrefabType::DeceptionPlatform:
-        Configure(EPlatformState::Solid, EPlatformState::Ghost, EPlatformState::TimedSolid);
-        break;
-    default:
-        Configure(EPlatformState::Solid, EPlatformState::Ghost, EPlatformState::TimedSolid);
-        break;
+        WorldBehaviors.Empty();
     }
 }
 
@@ -92,6 +101,24 @@ void UWorldShiftBehaviorComponent::RefreshGhostHintPreview(EWorldState PreviewWo
     UpdateGhostHint(PreviewWorld);
 }
 
+void UWorldShiftBehaviorComponent::NotifyWorldBehaviorsChanged()
+{
+    if (RegistryIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    BakeWorldTables();
+    AppliedMembershipMask = INDEX_NONE;
+
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
+    {
+        Registry->RefreshBehavior(this);
+    }
+
+    HandleWorldShift(CurrentWorld);
+}
+
 void UWorldShiftBehaviorComponent::BeginPlay()
 {
     Super::BeginPlay();
@@ -99,6 +126,11 @@ void UWorldShiftBehaviorComponent::BeginPlay()
     InitializeFromOwner();
     BindToWorldManager();
 
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
+    {
+        Registry->RegisterBehavior(this);
+    }
+
     if (CachedWorldManager.IsValid())
     {
         CurrentWorld = CachedWorldManager->GetCurrentWorld();
@@ -112,6 +144,11 @@ void UWorldShiftBehaviorComponent::BeginPlay()
 
 void UWorldShiftBehaviorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
+    {
+        Registry->UnregisterBehavior(this);
+    }
+
     UnbindFromWorldManager();
 
     Super::EndPlay(EndPlayReason);
@@ -121,9 +158,82 @@ void UWorldShiftBehaviorComponent::OnRegister()
 {
     Super::OnRegister();
 
+    BakeWorldTables();
     InitializeFromOwner();
 }
 
+#if WITH_EDITOR
+void UWorldShiftBehaviorComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    BakeWorldTables();
+}
+#endif
+
+void UWorldShiftBehaviorComponent::BakeWorldTables()
+{
+    ConfiguredWorldMask = 0;
+    WorldStateMasks = FWorldStateMasks();
+
+    const UWorldShiftProfile* ActiveProfile = GetActiveProfile();
+
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+    {
+        const EWorldState World = static_cast<EWorldState>(WorldIndex);
+
+        const EPlatformState* FoundState = WorldBehaviors.Find(World);
+        if (!FoundState && ActiveProfile)
+        {
+            FoundState = ActiveProfile->WorldBehaviors.Find(World);
+        }
+
+        if (FoundState)
+        {
+            ConfiguredWorldMask |= GetWorldBit(World);
+        }
+        WorldStateMasks.Set(World, FoundState ? *FoundState : EPlatformState::Solid);
+
+        const TObjectPtr<UMaterialInterface>* GhostMaterial = GhostMaterials.Find(World);
+        if (!GhostMaterial && ActiveProfile)
+        {
+            GhostMaterial = ActiveProfile->GhostMaterials.Find(World);
+        }
+        BakedGhostMaterials[WorldIndex] = GhostMaterial ? *GhostMaterial : nullptr;
+
+        const TObjectPtr<UMaterialInterface>* HintMaterial = GhostHintMaterials.Find(World);
+        if (!HintMaterial && ActiveProfile)
+        {
+            HintMaterial = ActiveProfile->GhostHintMaterials.Find(World);
+        }
+        BakedGhostHintMaterials[WorldIndex] = HintMaterial ? *HintMaterial : nullptr;
+    }
+
+    // Hint targets depend on every world's behavior, so they are resolved after the loop above.
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+    {
+        BakedHintWorlds[WorldIndex] = INDEX_NONE;
+
+        if (WorldStateMasks.GetBlockingMask() & (1u << WorldIndex))
+        {
+            continue;
+        }
+
+        for (int32 OtherWorldIndex = 0; OtherWorldIndex < WorldStateCount; ++OtherWorldIndex)
+        {
+            const uint32 OtherWorldBit = 1u << OtherWorldIndex;
+            if (OtherWorldIndex != WorldIndex && (ConfiguredWorldMask & OtherWorldBit) && (WorldStateMasks.GetBlockingMask() & OtherWorldBit))
+            {
+                BakedHintWorlds[WorldIndex] = static_cast<int8>(OtherWorldIndex);
+                break;
+            }
+        }
+    }
+
+    // Force the next UpdateGhostHint to apply, since materials may have changed for the same hint world.
+    AppliedHintWorldIndex = MAX_int8;
+}
+
 void UWorldShiftBehaviorComponent::InitializeFromOwner()
 {
     if (!TargetMesh)
@@ -137,6 +247,12 @@ void UWorldShiftBehaviorComponent::InitializeFromOwner()
     if (TargetMesh)
     {
         TargetMesh->SetVisibility(true, true);
+        bLookApplied = false;
+
+        if (bUseWorldAwareMaterial)
+        {
+            ApplyMaterial(WorldAwareMaterial ? WorldAwareMaterial.Get() : SolidMaterial.Get());
+        }
     }
 }
 
@@ -147,49 +263,57 @@ void UWorldShiftBehaviorComponent::BindToWorldManager()
         return;
     }
 
-    if (AWorldManager* Manager = AWorldManager::Get(GetWorld()))
+    // Runs immediately when the manager is already registered; otherwise the registry queues it until then.
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
     {
-        CachedWorldManager = Manager;
-        Manager->OnWorldShifted.AddDynamic(this, &UWorldShiftBehaviorComponent::HandleWorldShift);
-        Manager->OnTimedSolidPhaseChanged.AddDynamic(this, &UWorldShiftBehaviorComponent::HandleGlobalTimedSolidPhaseChanged);
-        Manager->OnTimedSolidPreWarning.AddDynamic(this, &UWorldShiftBehaviorComponent::HandleGlobalTimedSolidPreWarning);
+        Registry->WhenWorldManagerReady(FOnWorldManagerReadyNative::FDelegate::CreateUObject(this, &UWorldShiftBehaviorComponent::HandleWorldManagerReady));
     }
 }
 
-void UWorldShiftBehaviorComponent::UnbindFromWorldManager()
+void UWorldShiftBehaviorComponent::HandleWorldManagerReady(AWorldManager* Manager)
 {
-    if (!CachedWorldManager.IsValid())
-    {
-        return;
-    }
-
-    if (AWorldManager* Manager = CachedWorldManager.Get())
-    {
-        Manager->OnWorldShifted.RemoveDynamic(this, &UWorldShiftBehaviorComponent::HandleWorldShift);
-        Manager->OnTimedSolidPhaseChanged.RemoveDynamic(this, &UWorldShiftBehaviorComponent::HandleGlobalTimedSolidPhaseChanged);
-        Manager->OnTimedSolidPreWarning.RemoveDynamic(this, &UWorldShiftBehaviorComponent::HandleGlobalTimedSolidPreWarning);
-    }
+    // The manager's first broadcast reapplies the current world, so a late bind only needs to cache it.
+    CachedWorldManager = Manager;
+    bUseWorldCollisionChannels = Manager->UsesWorldCollisionChannels();
+}
 
+void UWorldShiftBehaviorComponent::UnbindFromWorldManager()
+{
+    // Timed solid events arrive through the world shift registry, so only the cached manager is dropped here.
     CachedWorldManager.Reset();
 }
 
 void UWorldShiftBehaviorComponent::HandleWorldShift(EWorldState NewWorld)
 {
+    ApplyWorldShift(NewWorld, GetBehaviorForWorld(NewWorld));
+}
+
+void UWorldShiftBehaviorComponent::ApplyWorldShift(EWorldState NewWorld, EPlatformState NewState)
+{
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftBehaviorApply);
+    INC_DWORD_STAT(STAT_WorldShiftShiftablesTouched);
+
     CurrentWorld = NewWorld;
-    const EPlatformState NewState = GetBehaviorForWorld(NewWorld);
     CurrentState = NewState;
+    ApplyWorldAwareState(NewState);
+    UpdateMembershipChannel();
     ApplyPlatformState(NewState, NewWorld);
     UpdateGhostHint(NewWorld);
     const bool bHandledByTimedState = (NewState == EPlatformState::TimedSolid);
     if (!bHandledByTimedState)
     {
         OnShiftStateChanged(CurrentState, NewWorld);
+        INC_DWORD_STAT(STAT_WorldShiftDelegateBroadcasts);
         OnStateChanged.Broadcast(CurrentState, NewWorld);
     }
 }
 
 void UWorldShiftBehaviorComponent::HandleGlobalTimedSolidPhaseChanged(bool bNowSolid)
 {
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftBehaviorTimedSolid);
+
+    UpdateMembershipChannel();
+
     if (GetBehaviorForWorld(CurrentWorld) != EPlatformState::TimedSolid)
     {
         return;
@@ -206,11 +330,16 @@ void UWorldShiftBehaviorComponent::HandleGlobalTimedSolidPhaseChanged(bool bNowS
 
     CurrentState = bNowSolid ? EPlatformState::Solid : EPlatformState::Ghost;
     OnShiftStateChanged(CurrentState, CurrentWorld);
+    INC_DWORD_STAT(STAT_WorldShiftDelegateBroadcasts);
     OnStateChanged.Broadcast(CurrentState, CurrentWorld);
 }
 
 void UWorldShiftBehaviorComponent::HandleGlobalTimedSolidPreWarning(bool bWillBeSolid)
 {
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftBehaviorTimedSolid);
+
+    UpdateMembershipChannel();
+
     if (GetBehaviorForWorld(CurrentWorld) != EPlatformState::TimedSolid)
     {
         return;
@@ -243,6 +372,7 @@ void UWorldShiftBehaviorComponent::ApplyPlatformState(EPlatformState NewState, E
             ApplySolidState();
             CurrentState = EPlatformState::Solid;
             OnShiftStateChanged(CurrentState, WorldContext);
+            INC_DWORD_STAT(STAT_WorldShiftDelegateBroadcasts);
             OnStateChanged.Broadcast(CurrentState, WorldContext);
         }
         break;
@@ -254,63 +384,73 @@ void UWorldShiftBehaviorComponent::ApplyPlatformState(EPlatformState NewState, E
 
 void UWorldShiftBehaviorComponent::ApplySolidState()
 {
-    if (!TargetMesh)
-    {
-        return;
-    }
+    ApplyLook(true, true, bUseWorldAwareMaterial ? nullptr : SolidMaterial.Get());
+}
 
-    TargetMesh->SetVisibility(true, true);
-    TargetMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+void UWorldShiftBehaviorComponent::ApplyGhostState(EWorldState WorldContext)
+{
+    ApplyLook(true, false, bUseWorldAwareMaterial ? nullptr : BakedGhostMaterials[static_cast<int32>(WorldContext)].Get());
+}
 
-    if (SolidMaterial)
-    {
-        ApplyMaterial(SolidMaterial.Get());
-    }
+void UWorldShiftBehaviorComponent::ApplyHiddenState()
+{
+    ApplyLook(false, false, nullptr);
 }
 
-void UWorldShiftBehaviorComponent::ApplyGhostState(EWorldState WorldContext)
+void UWorldShiftBehaviorComponent::ApplyPreWarningState()
+{
+    ApplyLook(true, false, bUseWorldAwareMaterial ? nullptr : PreWarningMaterial.Get());
+}
+
+void UWorldShiftBehaviorComponent::ApplyLook(bool bVisible, bool bCollisionEnabled, UMaterialInterface* Material)
 {
     if (!TargetMesh)
     {
         return;
     }
 
-    TargetMesh->SetVisibility(true, true);
-    TargetMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    bool bChanged = false;
 
-    if (const TObjectPtr<UMaterialInterface>* MaterialPtr = GhostMaterials.Find(WorldContext))
+    if (!bLookApplied || bVisible != bAppliedVisible)
     {
-        if (UMaterialInterface* Material = MaterialPtr->Get())
-        {
-            ApplyMaterial(Material);
-        }
+        TargetMesh->SetVisibility(bVisible, true);
+        bAppliedVisible = bVisible;
+        bChanged = true;
     }
-}
 
-void UWorldShiftBehaviorComponent::ApplyHiddenState()
-{
-    if (!TargetMesh)
+    if (!bUseWorldCollisionChannels && (!bLookApplied || bCollisionEnabled != bAppliedCollisionEnabled))
     {
-        return;
+        TargetMesh->SetCollisionEnabled(bCollisionEnabled ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+        bAppliedCollisionEnabled = bCollisionEnabled;
+        bChanged = true;
+        INC_DWORD_STAT(STAT_WorldShiftCollisionChanges);
+    }
+    else if (bUseWorldCollisionChannels && (!bLookApplied || bCollisionEnabled != bAppliedCollisionEnabled))
+    {
+        // Membership channels only filter bodies that respond to them; traces still read the mesh's own responses.
+        FCollisionResponseContainer Responses = TargetMesh->GetCollisionResponseToChannels();
+        Responses.SetResponse(ECC_Visibility, bCollisionEnabled ? AuthoredVisibilityResponse.GetValue() : ECR_Ignore);
+        Responses.SetResponse(ECC_Camera, bCollisionEnabled ? AuthoredCameraResponse.GetValue() : ECR_Ignore);
+        TargetMesh->SetCollisionResponseToChannels(Responses);
+        bAppliedCollisionEnabled = bCollisionEnabled;
+        bChanged = true;
+        INC_DWORD_STAT(STAT_WorldShiftCollisionChanges);
     }
 
-    TargetMesh->SetVisibility(false, true);
-    TargetMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-}
-
-void UWorldShiftBehaviorComponent::ApplyPreWarningState()
-{
-    if (!TargetMesh)
+    // A null material keeps whatever the mesh shows, matching the states that never swap materials.
+    if (Material && Material != AppliedMaterial)
     {
-        return;
+        ApplyMaterial(Material);
+        AppliedMaterial = Material;
+        bChanged = true;
+        INC_DWORD_STAT(STAT_WorldShiftMaterialChanges);
     }
 
-    TargetMesh->SetVisibility(true, true);
-    TargetMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    bLookApplied = true;
 
-    if (PreWarningMaterial)
+    if (!bChanged)
     {
-        ApplyMaterial(PreWarningMaterial.Get());
+        INC_DWORD_STAT(STAT_WorldShiftSkippedApplies);
     }
 }
 
@@ -333,57 +473,91 @@ void UWorldShiftBehaviorComponent::ApplyMaterial(UMaterialInterface* Material) c
     }
 }
 
-void UWorldShiftBehaviorComponent::UpdateGhostHint(EWorldState WorldContext)
+void UWorldShiftBehaviorComponent::ApplyWorldAwareState(EPlatformState WorldState) const
 {
-    if (!GhostHintMesh)
+    if (!bUseWorldAwareMaterial || !TargetMesh)
     {
         return;
     }
 
-    const EPlatformState Behavior = GetBehaviorForWorld(WorldContext);
-    const bool bActiveInCurrentWorld = Behavior == EPlatformState::Solid || Behavior == EPlatformState::TimedSolid;
+    // The material resolves TimedSolid against the collection's phase parameters, so this only changes on world shifts.
+    TargetMesh->SetCustomPrimitiveDataFloat(StateCustomDataIndex, static_cast<float>(WorldState));
+}
 
-    if (bActiveInCurrentWorld)
+void UWorldShiftBehaviorComponent::UpdateMembershipChannel()
+{
+    const AWorldManager* Manager = CachedWorldManager.Get();
+    if (!bUseWorldCollisionChannels || !TargetMesh || !Manager)
     {
-        GhostHintMesh->SetVisibility(false, true);
-        GhostHintMesh->SetHiddenInGame(true);
-        OnGhostHintUpdated();
         return;
     }
 
-    for (const TPair<EWorldState, EPlatformState>& Pair : WorldBehaviors)
+    // Timed solid worlds only count while the phase is solid; the pre-warning window is already passable.
+    uint8 MembershipMask = WorldStateMasks.Solid;
+    if (Manager->IsGlobalTimedSolidSolid() && !Manager->IsTimedSolidPreWarningActive())
     {
-        if (Pair.Key == WorldContext)
-        {
-            continue;
-        }
+        MembershipMask |= WorldStateMasks.TimedSolid;
+    }
 
-        if (Pair.Value == EPlatformState::Solid || Pair.Value == EPlatformState::TimedSolid)
-        {
-            GhostHintMesh->SetVisibility(true, true);
-            GhostHintMesh->SetHiddenInGame(false);
+    if (MembershipMask == AppliedMembershipMask)
+    {
+        return;
+    }
 
-            if (UMaterialInterface* HintMaterial = GhostHintMaterials.FindRef(Pair.Key))
-            {
-                GhostHintMesh->SetMaterial(0, HintMaterial);
-            }
+    if (AppliedMembershipMask == INDEX_NONE)
+    {
+        TargetMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+        bLookApplied = false;
 
-            OnGhostHintUpdated();
-            return;
+        if (!bAuthoredTraceResponsesCaptured)
+        {
+            AuthoredVisibilityResponse = TargetMesh->GetCollisionResponseToChannel(ECC_Visibility);
+            AuthoredCameraResponse = TargetMesh->GetCollisionResponseToChannel(ECC_Camera);
+            bAuthoredTraceResponsesCaptured = true;
         }
     }
 
-    GhostHintMesh->SetVisibility(false, true);
-    GhostHintMesh->SetHiddenInGame(true);
-    OnGhostHintUpdated();
+    AppliedMembershipMask = MembershipMask;
+    INC_DWORD_STAT(STAT_WorldShiftCollisionChanges);
+    TargetMesh->SetCollisionObjectType(Manager->GetWorldMembershipChannel(MembershipMask));
+}
+
+bool UWorldShiftBehaviorComponent::UsesSharedGhostHintPool() const
+{
+    return bUseSharedGhostHintPool && !(GhostHintMesh && GhostHintMesh->GetStaticMesh());
 }
 
-EPlatformState UWorldShiftBehaviorComponent::GetBehaviorForWorld(EWorldState WorldContext) const
+void UWorldShiftBehaviorComponent::UpdateGhostHint(EWorldState WorldContext)
 {
-    if (const EPlatformState* FoundState = WorldBehaviors.Find(WorldContext))
+    if (!GhostHintMesh || UsesSharedGhostHintPool())
+    {
+        return;
+    }
+
+    const int8 HintWorldIndex = BakedHintWorlds[static_cast<int32>(WorldContext)];
+    if (HintWorldIndex == AppliedHintWorldIndex)
+    {
+        return;
+    }
+
+    AppliedHintWorldIndex = HintWorldIndex;
+
+    if (HintWorldIndex == INDEX_NONE)
     {
-        return *FoundState;
+        GhostHintMesh->SetVisibility(false, true);
+        GhostHintMesh->SetHiddenInGame(true);
+        OnGhostHintUpdated();
+        return;
     }
 
-    return EPlatformState::Solid;
+    GhostHintMesh->SetVisibility(true, true);
+    GhostHintMesh->SetHiddenInGame(false);
+
+    if (UMaterialInterface* HintMaterial = BakedGhostHintMaterials[HintWorldIndex])
+    {
+        GhostHintMesh->SetMaterial(0, HintMaterial);
+    }
+
+    OnGhostHintUpdated();
 }
+
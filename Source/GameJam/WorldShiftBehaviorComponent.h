@@ -2,14 +2,14 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "ShiftPlatform.h"
 #include "WorldShiftTypes.h"
 #include "WorldShiftBehaviorComponent.generated.h"
 
 class UStaticMeshComponent;
 class UMaterialInterface;
 class AWorldManager;
-enum class EPlatformPrefabType : uint8;
-enum class EPlatformState : uint8;
+class UWorldShiftProfile;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FWorldShiftStateChangedSignature, EPlatformState, NewState, EWorldState, WorldContext);
 
@@ -30,11 +30,22 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Setup")
     TObjectPtr<UStaticMeshComponent> TargetMesh;
 
-    /** Optional ghost hint mesh that is toggled based on future solid states. */
+    /** Optional dedicated ghost hint mesh that is toggled based on future solid states. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Ghost Hint")
     TObjectPtr<UStaticMeshComponent> GhostHintMesh;
 
-    /** Per-world behavior mapping. */
+    /**
+     * Lets the world shift registry's shared pool draw the hint with a copy of the target mesh when GhostHintMesh
+     * has no static mesh assigned. Only worlds with a hint material are pooled.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Ghost Hint")
+    bool bUseSharedGhostHintPool = false;
+
+    /** Shared per-world behavior data. Entries in the maps below override it for this instance only. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift")
+    TObjectPtr<UWorldShiftProfile> Profile;
+
+    /** Per-instance behavior overrides layered on top of the profile. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift")
     TMap<EWorldState, EPlatformState> WorldBehaviors;
 
@@ -46,11 +57,27 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Materials")
     TObjectPtr<UMaterialInterface> PreWarningMaterial;
 
-    /** Ghost materials keyed by the world they correspond to. */
+    /**
+     * When enabled, solid, ghost and pre-warning looks come from one world-aware material that reads the
+     * world manager's parameter collection plus this component's state in custom primitive data.
+     * World shifts then never swap materials on the mesh.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Materials")
+    bool bUseWorldAwareMaterial = false;
+
+    /** Material applied once when the world-aware mode is enabled. Falls back to SolidMaterial. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Materials", meta = (EditCondition = "bUseWorldAwareMaterial"))
+    TObjectPtr<UMaterialInterface> WorldAwareMaterial;
+
+    /** Custom primitive data slot receiving the EPlatformState of the current world as a float. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Materials", meta = (EditCondition = "bUseWorldAwareMaterial", ClampMin = "0"))
+    int32 StateCustomDataIndex = 0;
+
+    /** Per-instance ghost material overrides keyed by the world they correspond to. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Materials")
     TMap<EWorldState, TObjectPtr<UMaterialInterface>> GhostMaterials;
 
-    /** Hint materials keyed by the world where the platform becomes solid. */
+    /** Per-instance hint material overrides keyed by the world where the platform becomes solid. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Materials")
     TMap<EWorldState, TObjectPtr<UMaterialInterface>> GhostHintMaterials;
 
@@ -68,15 +95,24 @@ public:
     /** Assigns the optional ghost hint mesh managed by the component. */
     void SetGhostHintMesh(UStaticMeshComponent* InMesh);
 
-    /** Clears and sets up the behavior map from a prefab definition. */
+    /**
+     * Uses the shared profile for the prefab when no explicit Profile is assigned and no instance behaviors
+     * are authored, dropping overrides that match the active profile.
+     */
     void EnsureWorldBehaviorsFromPrefab(EPlatformPrefabType PrefabType);
 
-    /** Clears the behavior map. */
+    /** Clears the per-instance behavior overrides. */
     void ResetWorldBehaviors();
 
+    /** Returns the assigned profile, or the prefab profile when none is assigned. */
+    UWorldShiftProfile* GetActiveProfile() const { return Profile ? Profile.Get() : PrefabProfile.Get(); }
+
     /** Forces the ghost hint mesh to refresh using the provided preview world. */
     void RefreshGhostHintPreview(EWorldState PreviewWorld);
 
+    /** Pushes runtime edits of WorldBehaviors or TargetMesh to the world shift registry and reapplies the current world. */
+    void NotifyWorldBehaviorsChanged();
+
     /** Native event fired when the platform state changes. */
     UPROPERTY(BlueprintAssignable, Category = "World Shift|Events")
     FWorldShiftStateChangedSignature OnStateChanged;
@@ -97,22 +133,54 @@ public:
     UFUNCTION(BlueprintCallable, Category = "World Shift")
     bool IsCurrentlySolid() const;
 
+    /** Returns the configured state for the supplied world, defaulting to Solid when none is authored. */
+    EPlatformState GetBehaviorForWorld(EWorldState WorldContext) const { return WorldStateMasks.Get(WorldContext); }
+
+    /** Returns whether the profile or the instance overrides define a state for the supplied world. */
+    bool HasBehaviorForWorld(EWorldState WorldContext) const { return (ConfiguredWorldMask & (1u << static_cast<uint32>(WorldContext))) != 0; }
+
+    /** Returns whether any world has a configured state. */
+    bool HasAnyWorldBehaviors() const { return ConfiguredWorldMask != 0; }
+
+    /** Returns the effective behavior of every world as per-state bitmasks. */
+    const FWorldStateMasks& GetWorldStateMasks() const { return WorldStateMasks; }
+
+    /** Returns the world whose solid look should be hinted while the supplied world is active, or INDEX_NONE. */
+    int32 GetGhostHintWorldIndex(EWorldState WorldContext) const { return BakedHintWorlds[static_cast<int32>(WorldContext)]; }
+
+    /** Returns whether the shared hint pool draws this behavior's hint instead of GhostHintMesh. */
+    bool UsesSharedGhostHintPool() const;
+
+    /** Returns the hint material for the supplied hinted world index. */
+    UMaterialInterface* GetGhostHintMaterial(int32 HintWorldIndex) const { return BakedGhostHintMaterials[HintWorldIndex]; }
+
 protected:
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void OnRegister() override;
 
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 private:
+    friend class UWorldShiftSubsystem;
+
     void InitializeFromOwner();
     void BindToWorldManager();
 
-    UFUNCTION()
+    /** Caches the world manager once it is registered with the world shift registry. */
+    void HandleWorldManagerReady(AWorldManager* Manager);
+
     void HandleWorldShift(EWorldState NewWorld);
 
-    UFUNCTION()
+    /** Applies an already resolved state for the supplied world. Called by the world shift registry. */
+    void ApplyWorldShift(EWorldState NewWorld, EPlatformState NewState);
+
+    /** Called by the world shift registry only while this behavior is TimedSolid in the active world. */
     void HandleGlobalTimedSolidPhaseChanged(bool bNowSolid);
 
-    UFUNCTION()
+    /** Called by the world shift registry only while this behavior is TimedSolid in the active world. */
     void HandleGlobalTimedSolidPreWarning(bool bWillBeSolid);
 
     void ApplyPlatformState(EPlatformState NewState, EWorldState WorldContext);
@@ -122,12 +190,76 @@ private:
     void ApplyPreWarningState();
     void ApplyMaterial(UMaterialInterface* Material) const;
 
+    /** Writes the world state to the target mesh's custom primitive data in world-aware material mode. */
+    void ApplyWorldAwareState(EPlatformState WorldState) const;
+
+    /** Points the target mesh at the object channel matching the worlds it is currently solid in. */
+    void UpdateMembershipChannel();
+
+    /**
+     * Applies visibility, collision (unless world collision channels are in use) and an optional material to
+     * the target mesh, skipping every part that matches what was last applied.
+     */
+    void ApplyLook(bool bVisible, bool bCollisionEnabled, UMaterialInterface* Material);
+
     void UpdateGhostHint(EWorldState WorldContext);
 
-    EPlatformState GetBehaviorForWorld(EWorldState WorldContext) const;
+    /** Flattens the profile and instance overrides into the per-world lookup tables used at runtime. */
+    void BakeWorldTables();
+
+    /** Removes instance map entries that match the active profile so only real overrides are stored. */
+    void RemoveRedundantOverrides();
 
     void UnbindFromWorldManager();
 
     TWeakObjectPtr<AWorldManager> CachedWorldManager;
+
+    /** Row index inside UWorldShiftSubsystem, or INDEX_NONE when not registered. */
+    int32 RegistryIndex = INDEX_NONE;
+
+    /** Built-in profile chosen by EnsureWorldBehaviorsFromPrefab. Never serialized. */
+    UPROPERTY(Transient)
+    TObjectPtr<UWorldShiftProfile> PrefabProfile;
+
+    /** Effective behaviors of every world, one bitmask per state. */
+    FWorldStateMasks WorldStateMasks;
+
+    /** Effective ghost materials flattened by world index. */
+    UPROPERTY(Transient)
+    TObjectPtr<UMaterialInterface> BakedGhostMaterials[WorldStateCount];
+
+    /** Effective ghost hint materials flattened by world index. */
+    UPROPERTY(Transient)
+    TObjectPtr<UMaterialInterface> BakedGhostHintMaterials[WorldStateCount];
+
+    /** Hinted world index per active world, or INDEX_NONE when no hint is shown. */
+    int8 BakedHintWorlds[WorldStateCount];
+
+    /** Hint world last applied to GhostHintMesh, or MAX_int8 when the next update must apply. */
+    int8 AppliedHintWorldIndex = MAX_int8;
+
+    /** Bit per world index set when the profile or the overrides define a state. */
+    uint8 ConfiguredWorldMask = 0;
+
+    /** Target mesh trace responses captured before channel mode first changed them; restored while solid. */
+    TEnumAsByte<ECollisionResponse> AuthoredVisibilityResponse = ECR_Block;
+    TEnumAsByte<ECollisionResponse> AuthoredCameraResponse = ECR_Block;
+    bool bAuthoredTraceResponsesCaptured = false;
+
+    /** Membership bitmask last written to the target mesh's object type, or INDEX_NONE when none was written. */
+    int32 AppliedMembershipMask = INDEX_NONE;
+
+    /** Whether bAppliedVisible and bAppliedCollisionEnabled reflect the target mesh. */
+    bool bLookApplied = false;
+
+    bool bAppliedVisible = true;
+
+    bool bAppliedCollisionEnabled = true;
+
+    /** Material last written by ApplyLook. Assets stay referenced by the material properties above. */
+    const UMaterialInterface* AppliedMaterial = nullptr;
+
+    /** Cached from the world manager when binding; collision is then expressed through object channels. */
+    bool bUseWorldCollisionChannels = false;
 };
 
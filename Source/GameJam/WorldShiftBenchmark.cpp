@@ -0,0 +1,367 @@
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameJam.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ShiftPlatform.h"
+#include "WorldManager.h"
+#include "WorldShiftSubsystem.h"
+
+/**
+ * Headless world shift benchmark.
+ *
+ * Spawns grids of mixed-prefab AShiftPlatforms and times SetWorld, CycleWorld and a full timed solid cycle
+ * (both pre-warnings and both phase changes). Results go to Saved/Perf as CSV. With a baseline CSV the test
+ * fails when a scenario's median regresses by more than the threshold.
+ *
+ * Allocations are attributed with a Low Level Memory Tracker tag scoped to the measured loop. LLM scopes are
+ * per thread, so only the game thread's allocations are counted; the column is the net bytes the loop left
+ * allocated and stays 0 unless the run uses -llm.
+ *
+ * Usage:
+ *   -game -nullrhi -unattended -llm -ExecCmds="Automation RunTests GameJam.Perf.WorldShift; Quit"
+ *   Optional: -WorldShiftPerfCounts=1000,10000,50000 -WorldShiftPerfIterations=50 -WorldShiftPerfMesh=<path>
+ *             -WorldShiftPerfBaseline=<csv> -WorldShiftPerfThreshold=<percent>
+ */
+LLM_DEFINE_TAG(WorldShiftBenchmark);
+
+namespace WorldShiftBenchmark
+{
+    static int64 GetTrackedBytes()
+    {
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+        if (FLowLevelMemTracker::IsEnabled())
+        {
+            // Folds the per-thread tracking state into the tag totals before reading them.
+            FLowLevelMemTracker::Get().UpdateStatsPerFrame();
+            return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, FName(TEXT("WorldShiftBenchmark")), ELLMTagSet::None);
+        }
+#endif
+        return 0;
+    }
+
+    /** Timings and game thread allocations of one scenario at one platform count. */
+    struct FResult
+    {
+        FString Scenario;
+        int32 Platforms = 0;
+        int32 Iterations = 0;
+        double MinMs = 0.0;
+        double MedianMs = 0.0;
+        double P99Ms = 0.0;
+        int64 AllocatedBytes = 0;
+    };
+
+    static FString MakeKey(const FString& Scenario, int32 Platforms)
+    {
+        return FString::Printf(TEXT("%s@%d"), *Scenario, Platforms);
+    }
+
+    /** Runs Body once per iteration after two warm-up calls and summarizes the samples. */
+    template <typename BodyType>
+    static FResult Measure(const TCHAR* Scenario, int32 Platforms, int32 Iterations, BodyType&& Body)
+    {
+        Body();
+        Body();
+
+        TArray<double> Samples;
+        Samples.Reserve(Iterations);
+
+        // Read outside the tag scope so the sample array and logging stay out of the measurement.
+        const int64 StartBytes = GetTrackedBytes();
+        {
+            LLM_SCOPE_BYTAG(WorldShiftBenchmark);
+            TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(Scenario);
+
+            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+            {
+                const uint64 StartCycles = FPlatformTime::Cycles64();
+                Body();
+                Samples.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+            }
+        }
+        const int64 EndBytes = GetTrackedBytes();
+
+        Samples.Sort();
+
+        FResult Result;
+        Result.Scenario = Scenario;
+        Result.Platforms = Platforms;
+        Result.Iterations = Iterations;
+        Result.MinMs = Samples[0];
+        Result.MedianMs = Samples[Samples.Num() / 2];
+        Result.P99Ms = Samples[FMath::Clamp(FMath::CeilToInt(Samples.Num() * 0.99) - 1, 0, Samples.Num() - 1)];
+        Result.AllocatedBytes = EndBytes - StartBytes;
+        return Result;
+    }
+
+    static void SpawnGrid(UWorld* World, int32 Count, UStaticMesh* Mesh, TArray<AShiftPlatform*>& OutPlatforms)
+    {
+        constexpr double Spacing = 400.0;
+        // Far below the playable space so the grid never overlaps level geometry or the player.
+        const FVector Origin(0.0, 0.0, -200000.0);
+        const int32 Columns = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count))));
+        const int32 PrefabCount = static_cast<int32>(EPlatformPrefabType::DeceptionPlatform) + 1;
+
+        OutPlatforms.Reset(Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const FVector Location = Origin + FVector((Index % Columns) * Spacing, (Index / Columns) * Spacing, 0.0);
+            AShiftPlatform* Platform = World->SpawnActorDeferred<AShiftPlatform>(AShiftPlatform::StaticClass(), FTransform(Location));
+            if (!Platform)
+            {
+                continue;
+            }
+
+            Platform->SetPrefabType(static_cast<EPlatformPrefabType>(Index % PrefabCount));
+            if (Mesh)
+            {
+                Platform->GetPlatformMesh()->SetStaticMesh(Mesh);
+            }
+
+            Platform->FinishSpawning(FTransform(Location));
+            OutPlatforms.Add(Platform);
+        }
+    }
+
+    static bool LoadBaseline(const FString& Path, TMap<FString, double>& OutMedians)
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+        {
+            return false;
+        }
+
+        // Skips the header; columns match WriteCsv.
+        for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+        {
+            TArray<FString> Columns;
+            Lines[LineIndex].ParseIntoArray(Columns, TEXT(","));
+            if (Columns.Num() >= 5)
+            {
+                OutMedians.Add(MakeKey(Columns[0], FCString::Atoi(*Columns[1])), FCString::Atod(*Columns[4]));
+            }
+        }
+
+        return true;
+    }
+
+    static FString WriteCsv(const TArray<FResult>& Results)
+    {
+        FString Csv = TEXT("Scenario,Platforms,Iterations,MinMs,MedianMs,P99Ms,GameThreadBytes\n");
+        for (const FResult& Result : Results)
+        {
+            Csv += FString::Printf(TEXT("%s,%d,%d,%.4f,%.4f,%.4f,%lld\n"), *Result.Scenario, Result.Platforms, Result.Iterations,
+                Result.MinMs, Result.MedianMs, Result.P99Ms, Result.AllocatedBytes);
+        }
+
+        const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Perf"),
+            FString::Printf(TEXT("WorldShift_%s.csv"), *FDateTime::Now().ToString()));
+        return FFileHelper::SaveStringToFile(Csv, *Path) ? Path : FString();
+    }
+
+    /** The first game or PIE world that has begun play. */
+    static UWorld* FindGameWorld()
+    {
+        if (!GEngine)
+        {
+            return nullptr;
+        }
+
+        for (const FWorldContext& Context : GEngine->GetWorldContexts())
+        {
+            UWorld* World = Context.World();
+            if (World && (Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && World->HasBegunPlay())
+            {
+                return World;
+            }
+        }
+
+        return nullptr;
+    }
+
+    static void Run(FAutomationTestBase& Test, UWorld* World)
+    {
+        const TCHAR* CommandLine = FCommandLine::Get();
+
+        FString CountsString = TEXT("1000,10000,50000");
+        FParse::Value(CommandLine, TEXT("WorldShiftPerfCounts="), CountsString);
+        int32 Iterations = 50;
+        FParse::Value(CommandLine, TEXT("WorldShiftPerfIterations="), Iterations);
+        Iterations = FMath::Max(1, Iterations);
+        float ThresholdPercent = 10.0f;
+        FParse::Value(CommandLine, TEXT("WorldShiftPerfThreshold="), ThresholdPercent);
+        FString BaselinePath;
+        FParse::Value(CommandLine, TEXT("WorldShiftPerfBaseline="), BaselinePath);
+        FString MeshPath = TEXT("/Engine/BasicShapes/Cube.Cube");
+        FParse::Value(CommandLine, TEXT("WorldShiftPerfMesh="), MeshPath);
+
+        TArray<FString> CountStrings;
+        CountsString.ParseIntoArray(CountStrings, TEXT(","));
+
+        AWorldManager* Manager = AWorldManager::Get(World);
+        AWorldManager* SpawnedManager = nullptr;
+        if (!Manager)
+        {
+            SpawnedManager = World->SpawnActor<AWorldManager>();
+            Manager = SpawnedManager;
+        }
+
+        UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(World);
+        if (!Manager || !Registry)
+        {
+            Test.AddError(TEXT("Could not resolve the world manager or the world shift registry."));
+            return;
+        }
+
+        // Time slicing would move most of the work out of the measured call.
+        const FWorldShiftTimeSlicing PreviousTimeSlicing = Registry->GetTimeSlicing();
+        Registry->SetTimeSlicing(FWorldShiftTimeSlicing());
+
+        UStaticMesh* Mesh = MeshPath.IsEmpty() ? nullptr : LoadObject<UStaticMesh>(nullptr, *MeshPath);
+        const EWorldState StartWorld = Manager->GetCurrentWorld();
+
+        TArray<FResult> Results;
+        TArray<AShiftPlatform*> Platforms;
+        for (const FString& CountString : CountStrings)
+        {
+            const int32 Count = FCString::Atoi(*CountString);
+            if (Count <= 0)
+            {
+                continue;
+            }
+
+            SpawnGrid(World, Count, Mesh, Platforms);
+
+            int32 WorldIndex = static_cast<int32>(Manager->GetCurrentWorld());
+            Results.Add(Measure(TEXT("SetWorld"), Count, Iterations, [&]()
+            {
+                WorldIndex = (WorldIndex + 1) % WorldStateCount;
+                Manager->SetWorld(static_cast<EWorldState>(WorldIndex));
+                Manager->CommitPendingWorld();
+            }));
+
+            // Shift requests are normally committed at the end of the frame; commit each one to time the full apply.
+            Results.Add(Measure(TEXT("CycleWorld"), Count, Iterations, [&]()
+            {
+                Manager->CycleWorld(1);
+                Manager->CommitPendingWorld();
+            }));
+
+            // Mirrors AWorldManager's phase handlers: registry dispatch first, then Blueprint listeners.
+            Results.Add(Measure(TEXT("TimedSolidCycle"), Count, Iterations, [&]()
+            {
+                for (const bool bSolid : {false, true})
+                {
+                    Registry->DispatchTimedSolidPreWarning(bSolid);
+                    Manager->OnTimedSolidPreWarning.Broadcast(bSolid);
+                    Registry->DispatchTimedSolidPhaseChanged(bSolid);
+                    Manager->OnTimedSolidPhaseChanged.Broadcast(bSolid);
+                }
+            }));
+
+            for (AShiftPlatform* Platform : Platforms)
+            {
+                Platform->Destroy();
+            }
+            Platforms.Reset();
+        }
+
+        Manager->SetWorld(StartWorld);
+        Manager->CommitPendingWorld();
+        Registry->SetTimeSlicing(PreviousTimeSlicing);
+        if (SpawnedManager)
+        {
+            SpawnedManager->Destroy();
+        }
+
+        for (const FResult& Result : Results)
+        {
+            UE_LOG(LogGameJam, Display, TEXT("WorldShift perf %-16s %6d platforms: min %.3f ms, median %.3f ms, p99 %.3f ms, %lld game thread bytes"),
+                *Result.Scenario, Result.Platforms, Result.MinMs, Result.MedianMs, Result.P99Ms, Result.AllocatedBytes);
+        }
+
+        const FString CsvPath = WriteCsv(Results);
+        if (CsvPath.IsEmpty())
+        {
+            Test.AddWarning(TEXT("WorldShift perf results could not be written to Saved/Perf."));
+        }
+        else
+        {
+            Test.AddInfo(FString::Printf(TEXT("WorldShift perf results written to %s"), *CsvPath));
+        }
+
+        if (Results.Num() == 0)
+        {
+            Test.AddError(FString::Printf(TEXT("No platform counts to measure in '%s'."), *CountsString));
+        }
+
+        if (BaselinePath.IsEmpty())
+        {
+            return;
+        }
+
+        if (FPaths::IsRelative(BaselinePath))
+        {
+            BaselinePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Perf"), BaselinePath);
+        }
+
+        TMap<FString, double> BaselineMedians;
+        if (!LoadBaseline(BaselinePath, BaselineMedians))
+        {
+            Test.AddError(FString::Printf(TEXT("WorldShift perf baseline '%s' could not be read."), *BaselinePath));
+            return;
+        }
+
+        for (const FResult& Result : Results)
+        {
+            const double* BaselineMedian = BaselineMedians.Find(MakeKey(Result.Scenario, Result.Platforms));
+            if (!BaselineMedian || *BaselineMedian <= 0.0)
+            {
+                continue;
+            }
+
+            const double ChangePercent = (Result.MedianMs / *BaselineMedian - 1.0) * 100.0;
+            if (ChangePercent > ThresholdPercent)
+            {
+                Test.AddError(FString::Printf(TEXT("WorldShift perf regression: %s at %d platforms median %.3f ms vs %.3f ms baseline (+%.1f%%)."),
+                    *Result.Scenario, Result.Platforms, Result.MedianMs, *BaselineMedian, ChangePercent));
+            }
+            else
+            {
+                Test.AddInfo(FString::Printf(TEXT("WorldShift perf %s at %d platforms: %+.1f%% vs baseline."),
+                    *Result.Scenario, Result.Platforms, ChangePercent));
+            }
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldShiftPerfTest, "GameJam.Perf.WorldShift",
+    EAutomationTestFlags::PerfFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
+
+bool FWorldShiftPerfTest::RunTest(const FString& Parameters)
+{
+    UWorld* World = WorldShiftBenchmark::FindGameWorld();
+    if (!World)
+    {
+        AddError(TEXT("GameJam.Perf.WorldShift needs a running game world; run it with -game or during PIE."));
+        return false;
+    }
+
+    WorldShiftBenchmark::Run(*this, World);
+    return true;
+}
+
+#endif
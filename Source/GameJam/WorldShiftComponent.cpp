@@ -1,12 +1,11 @@
 #include "WorldShiftComponent.h"
 #include "WorldManager.h"
+#include "WorldShiftSubsystem.h"
 #include "GameFramework/Actor.h"
 
 #include "Components/PrimitiveComponent.h"
 #include "Components/ActorComponent.h"
 
-#include "Components/PrimitiveComponent.h"
-
 UWorldShiftComponent::UWorldShiftComponent()
 {
     PrimaryComponentTick.bCanEverTick = false;
@@ -17,43 +16,25 @@ void UWorldShiftComponent::BeginPlay()
 {
     Super::BeginPlay();
 
-    BindToWorldManager();
-
-    if (CachedWorldManager.IsValid())
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
     {
-        OnWorldShift(CachedWorldManager->GetCurrentWorld());
+        Registry->OnWorldShiftedNative.AddUObject(this, &UWorldShiftComponent::HandleWorldShift);
     }
-}
 
-void UWorldShiftComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
-{
-    if (CachedWorldManager.IsValid())
+    if (AWorldManager* Manager = AWorldManager::Get(GetWorld()))
     {
-        CachedWorldManager->OnWorldShifted.RemoveDynamic(this, &UWorldShiftComponent::HandleWorldShift);
+        OnWorldShift(Manager->GetCurrentWorld());
     }
-
-    Super::EndPlay(EndPlayReason);
 }
 
-void UWorldShiftComponent::OnRegister()
-{
-    Super::OnRegister();
-
-    BindToWorldManager();
-}
-
-void UWorldShiftComponent::BindToWorldManager()
+void UWorldShiftComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    if (CachedWorldManager.IsValid())
+    if (UWorldShiftSubsystem* Registry = UWorldShiftSubsystem::Get(GetWorld()))
     {
-        return;
+        Registry->OnWorldShiftedNative.RemoveAll(this);
     }
 
-    if (AWorldManager* Manager = AWorldManager::Get(GetWorld()))
-    {
-        CachedWorldManager = Manager;
-        Manager->OnWorldShifted.AddDynamic(this, &UWorldShiftComponent::HandleWorldShift);
-    }
+    Super::EndPlay(EndPlayReason);
 }
 
 void UWorldShiftComponent::HandleWorldShift(EWorldState NewWorld)
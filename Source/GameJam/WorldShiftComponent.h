@@ -5,8 +5,6 @@
 #include "WorldShiftTypes.h"
 #include "WorldShiftComponent.generated.h"
 
-class AWorldManager;
-
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWorldShiftComponentSignature, EWorldState, NewWorld);
 
 UCLASS(ClassGroup = (WorldShift), meta = (BlueprintSpawnableComponent))
@@ -28,14 +26,9 @@ public:
     virtual void OnWorldShift(EWorldState NewWorld);
 
 protected:
-    virtual void OnRegister() override;
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
-    void BindToWorldManager();
-    UFUNCTION()
     void HandleWorldShift(EWorldState NewWorld);
-
-    TWeakObjectPtr<AWorldManager> CachedWorldManager;
 };
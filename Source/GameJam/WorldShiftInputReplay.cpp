@@ -0,0 +1,604 @@
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "EnhancedInputComponent.h"
+#include "EnhancedInputSubsystems.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameJam.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "InputAction.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "WorldManager.h"
+
+/**
+ * Input record and replay harness for reproducing performance issues.
+ *
+ * Recording stores the frame's delta time and the value of every Enhanced Input action bound on the player
+ * pawn (Move, Look, Jump, CycleWorld, ...) once per frame. Only actions whose value changed are written, so
+ * idle frames cost a few bytes. Replay runs under a fixed timestep and writes the frame times to Saved/Perf
+ * as CSV, so the same shift sequence can be compared across builds.
+ *
+ * By default every replayed frame advances by the recorded delta, reproducing the original timeline exactly.
+ * With Fps= the recording is resampled onto that fixed step instead: each step injects the values of the last
+ * recorded frame it covers, and presses shorter than a step are held for one step so they are not lost.
+ *
+ * Both sides run after actor ticks. A value recorded at the end of frame N is injected at the end of frame
+ * N - 1, together with frame N's delta, so the player controller consumes it in frame N like the original.
+ *
+ * Usage:
+ *   GameJam.Input.Record Start File=ShiftSection
+ *   GameJam.Input.Record Stop
+ *   -game -nullrhi -unattended -ExecCmds="GameJam.Input.Replay File=ShiftSection Exit=1"
+ */
+namespace WorldShiftInputReplay
+{
+    static constexpr uint32 FileMagic = 0x52494A47; // "GJIR"
+    static constexpr int32 FileVersion = 2;
+
+    /** Actions are tracked with a 32-bit changed mask per frame. */
+    static constexpr int32 MaxActions = 32;
+
+    /** Per-frame measurements written to the replay CSV. */
+    struct FFrameTiming
+    {
+        double StepMs = 0.0;
+        double FrameMs = 0.0;
+        double GameThreadMs = 0.0;
+        int32 WorldIndex = 0;
+    };
+
+    struct FState
+    {
+        TWeakObjectPtr<UWorld> World;
+        FDelegateHandle TickHandle;
+        FString Name;
+
+        bool bRecording = false;
+        bool bReplaying = false;
+        bool bExitWhenDone = false;
+
+        /** Actions in file order. Recording fills these from the pawn; replay resolves them by path name. */
+        TArray<TWeakObjectPtr<const UInputAction>> Actions;
+        TArray<FString> ActionPaths;
+        TArray<FInputActionValue> Values;
+
+        /** Recorded stream, or the stream being replayed. */
+        TArray<uint8> Data;
+        TUniquePtr<FMemoryWriter> Writer;
+        TUniquePtr<FMemoryReader> Reader;
+        int32 NumFrames = 0;
+        int32 Frame = 0;
+
+        /** Replay step when resampling, or 0 to replay with the recorded deltas. */
+        float ResampleStep = 0.0f;
+
+        /** Recorded time decoded so far and replay time injected so far, in seconds. Only used when resampling. */
+        double RecordedTime = 0.0;
+        double ReplayTime = 0.0;
+
+        /** Delta of the next recorded frame, read ahead while resampling. */
+        float NextDelta = 0.0f;
+        bool bHasNextDelta = false;
+
+        /** Fixed delta of the frame currently being simulated, for the CSV. */
+        float CurrentStep = 0.0f;
+
+        bool bPreviousUseFixedTimeStep = false;
+        double PreviousFixedDeltaTime = 0.0;
+
+        /** The first post-tick after the command belongs to the frame that ran it and is not measured. */
+        bool bFirstReplayFrame = true;
+
+        double LastFrameTime = 0.0;
+        TArray<FFrameTiming> Timings;
+    };
+
+    static FState State;
+
+    static FString GetReplayPath(const FString& Name)
+    {
+        return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("InputReplays"), Name + TEXT(".gjinput"));
+    }
+
+    static UEnhancedInputComponent* GetPawnInput(UWorld* World)
+    {
+        const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+        const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+        return Pawn ? Cast<UEnhancedInputComponent>(Pawn->InputComponent) : nullptr;
+    }
+
+    static int32 GetNumComponents(EInputActionValueType ValueType)
+    {
+        switch (ValueType)
+        {
+        case EInputActionValueType::Axis2D:
+            return 2;
+        case EInputActionValueType::Axis3D:
+            return 3;
+        default:
+            return 1;
+        }
+    }
+
+    static void SerializeValue(FArchive& Ar, FInputActionValue& Value, EInputActionValueType ValueType)
+    {
+        FVector Axis = Value.Get<FVector>();
+        for (int32 Component = 0; Component < GetNumComponents(ValueType); ++Component)
+        {
+            float ComponentValue = static_cast<float>(Axis[Component]);
+            Ar << ComponentValue;
+            Axis[Component] = ComponentValue;
+        }
+
+        if (Ar.IsLoading())
+        {
+            Value = FInputActionValue(ValueType, Axis);
+        }
+    }
+
+    /** Deltas are stored as packed whole microseconds, two or three bytes at common frame rates. */
+    static void SerializeDelta(FArchive& Ar, float& DeltaSeconds)
+    {
+        uint32 DeltaMicroseconds = static_cast<uint32>(FMath::Max(FMath::RoundToInt(DeltaSeconds * 1.0e6f), 0));
+        Ar.SerializeIntPacked(DeltaMicroseconds);
+        DeltaSeconds = DeltaMicroseconds * 1.0e-6f;
+    }
+
+    static void Stop()
+    {
+        if (State.TickHandle.IsValid())
+        {
+            FWorldDelegates::OnWorldPostActorTick.Remove(State.TickHandle);
+            State.TickHandle.Reset();
+        }
+
+        State.Writer.Reset();
+        State.Reader.Reset();
+        State.bRecording = false;
+        State.bReplaying = false;
+    }
+
+    static void FinishRecording()
+    {
+        TArray<uint8> File;
+        FMemoryWriter Ar(File);
+
+        uint32 Magic = FileMagic;
+        int32 Version = FileVersion;
+        Ar << Magic << Version << State.NumFrames << State.ActionPaths;
+        for (const TWeakObjectPtr<const UInputAction>& Action : State.Actions)
+        {
+            uint8 ValueType = Action.IsValid() ? static_cast<uint8>(Action->ValueType) : 0;
+            Ar << ValueType;
+        }
+        File.Append(State.Data);
+
+        const FString Path = GetReplayPath(State.Name);
+        const bool bSaved = FFileHelper::SaveArrayToFile(File, *Path);
+        UE_LOG(LogGameJam, Display, TEXT("Input recording of %d frames (%d bytes) %s %s."), State.NumFrames, File.Num(),
+            bSaved ? TEXT("written to") : TEXT("could not be written to"), *Path);
+
+        Stop();
+    }
+
+    static void RecordFrame(UWorld* World, float DeltaSeconds)
+    {
+        UEnhancedInputComponent* Input = GetPawnInput(World);
+        if (!Input)
+        {
+            return;
+        }
+
+        uint32 ChangedMask = 0;
+        TArray<FInputActionValue, TInlineAllocator<MaxActions>> NewValues;
+        for (int32 ActionIndex = 0; ActionIndex < State.Actions.Num(); ++ActionIndex)
+        {
+            const UInputAction* Action = State.Actions[ActionIndex].Get();
+            const FInputActionValue Value = Action ? Input->GetBoundActionValue(Action) : FInputActionValue();
+            NewValues.Add(Value);
+            if (Value.Get<FVector>() != State.Values[ActionIndex].Get<FVector>())
+            {
+                ChangedMask |= 1u << ActionIndex;
+            }
+        }
+
+        SerializeDelta(*State.Writer, DeltaSeconds);
+        State.Writer->SerializeIntPacked(ChangedMask);
+        for (int32 ActionIndex = 0; ActionIndex < State.Actions.Num(); ++ActionIndex)
+        {
+            if (ChangedMask & (1u << ActionIndex))
+            {
+                State.Values[ActionIndex] = NewValues[ActionIndex];
+                SerializeValue(*State.Writer, State.Values[ActionIndex], State.Values[ActionIndex].GetValueType());
+            }
+        }
+
+        ++State.NumFrames;
+    }
+
+    /** Reads the next recorded frame's delta. Returns false at the end of the recording. */
+    static bool ReadDelta(float& OutDelta)
+    {
+        if (State.Frame >= State.NumFrames || State.Reader->AtEnd())
+        {
+            return false;
+        }
+
+        SerializeDelta(*State.Reader, OutDelta);
+        return !State.Reader->IsError();
+    }
+
+    /** Reads the values of the frame whose delta was just read into State.Values. */
+    static void ReadValues()
+    {
+        uint32 ChangedMask = 0;
+        State.Reader->SerializeIntPacked(ChangedMask);
+        for (int32 ActionIndex = 0; ActionIndex < State.Values.Num(); ++ActionIndex)
+        {
+            if (ChangedMask & (1u << ActionIndex))
+            {
+                SerializeValue(*State.Reader, State.Values[ActionIndex], State.Values[ActionIndex].GetValueType());
+            }
+        }
+
+        ++State.Frame;
+    }
+
+    static void InjectValues(UWorld* World, const TArray<FInputActionValue>& Values)
+    {
+        const APlayerController* PlayerController = World->GetFirstPlayerController();
+        UEnhancedInputLocalPlayerSubsystem* InputSubsystem = PlayerController
+            ? ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer())
+            : nullptr;
+
+        if (!InputSubsystem)
+        {
+            return;
+        }
+
+        // Injected input only lasts one frame, so held values are injected again every frame.
+        for (int32 ActionIndex = 0; ActionIndex < State.Actions.Num(); ++ActionIndex)
+        {
+            const UInputAction* Action = State.Actions[ActionIndex].Get();
+            if (Action && Values[ActionIndex].IsNonZero())
+            {
+                InputSubsystem->InjectInputForAction(Action, Values[ActionIndex], {}, {});
+            }
+        }
+    }
+
+    /** Sets up the next frame with the recorded delta and values. Returns false once the recording is exhausted. */
+    static bool InjectNextFrame(UWorld* World)
+    {
+        float Delta = 0.0f;
+        if (!ReadDelta(Delta))
+        {
+            return false;
+        }
+
+        ReadValues();
+        State.CurrentStep = Delta;
+        FApp::SetFixedDeltaTime(Delta);
+        InjectValues(World, State.Values);
+        return true;
+    }
+
+    /** Sets up the next fixed step with the last recorded frame it covers. Returns false once the recording is exhausted. */
+    static bool InjectNextResampledFrame(UWorld* World)
+    {
+        State.ReplayTime += State.ResampleStep;
+
+        // Last non-zero value of each action within the step, so a tap shorter than the step still lands.
+        TArray<FInputActionValue, TInlineAllocator<MaxActions>> HeldValues;
+        HeldValues.SetNum(State.Values.Num());
+
+        bool bConsumedAny = false;
+        while (true)
+        {
+            if (!State.bHasNextDelta)
+            {
+                State.bHasNextDelta = ReadDelta(State.NextDelta);
+                if (!State.bHasNextDelta)
+                {
+                    break;
+                }
+            }
+
+            // Half a step of tolerance keeps recordings made at the replay rate from drifting by a frame.
+            if (State.RecordedTime + State.NextDelta > State.ReplayTime + State.ResampleStep * 0.5)
+            {
+                break;
+            }
+
+            State.RecordedTime += State.NextDelta;
+            State.bHasNextDelta = false;
+            ReadValues();
+            bConsumedAny = true;
+
+            for (int32 ActionIndex = 0; ActionIndex < State.Values.Num(); ++ActionIndex)
+            {
+                if (State.Values[ActionIndex].IsNonZero())
+                {
+                    HeldValues[ActionIndex] = State.Values[ActionIndex];
+                }
+            }
+        }
+
+        if (!bConsumedAny && !State.bHasNextDelta)
+        {
+            return false;
+        }
+
+        TArray<FInputActionValue> StepValues(State.Values);
+        for (int32 ActionIndex = 0; ActionIndex < StepValues.Num(); ++ActionIndex)
+        {
+            if (!StepValues[ActionIndex].IsNonZero())
+            {
+                StepValues[ActionIndex] = HeldValues[ActionIndex];
+            }
+        }
+
+        State.CurrentStep = State.ResampleStep;
+        InjectValues(World, StepValues);
+        return true;
+    }
+
+    static void FinishReplay()
+    {
+        FApp::SetUseFixedTimeStep(State.bPreviousUseFixedTimeStep);
+        FApp::SetFixedDeltaTime(State.PreviousFixedDeltaTime);
+
+        FString Csv = TEXT("Frame,StepMs,FrameMs,GameThreadMs,World\n");
+        TArray<double> FrameTimes;
+        for (int32 FrameIndex = 0; FrameIndex < State.Timings.Num(); ++FrameIndex)
+        {
+            const FFrameTiming& Timing = State.Timings[FrameIndex];
+            Csv += FString::Printf(TEXT("%d,%.4f,%.4f,%.4f,%d\n"), FrameIndex, Timing.StepMs, Timing.FrameMs, Timing.GameThreadMs, Timing.WorldIndex);
+            FrameTimes.Add(Timing.FrameMs);
+        }
+
+        const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Perf"),
+            FString::Printf(TEXT("InputReplay_%s_%s.csv"), *State.Name, *FDateTime::Now().ToString()));
+        const bool bSaved = FFileHelper::SaveStringToFile(Csv, *Path);
+
+        if (FrameTimes.Num() > 0)
+        {
+            FrameTimes.Sort();
+            UE_LOG(LogGameJam, Display, TEXT("Input replay %s: %d frames, median %.3f ms, p99 %.3f ms, max %.3f ms."), *State.Name,
+                FrameTimes.Num(), FrameTimes[FrameTimes.Num() / 2],
+                FrameTimes[FMath::Clamp(FMath::CeilToInt(FrameTimes.Num() * 0.99) - 1, 0, FrameTimes.Num() - 1)], FrameTimes.Last());
+        }
+        UE_LOG(LogGameJam, Display, TEXT("Input replay frame times written to %s"), bSaved ? *Path : TEXT("<failed>"));
+
+        const bool bExit = State.bExitWhenDone;
+        Stop();
+        State.Timings.Reset();
+
+        if (bExit)
+        {
+            FPlatformMisc::RequestExitWithStatus(false, bSaved ? 0 : 1);
+        }
+    }
+
+    static void HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+    {
+        if (World != State.World.Get())
+        {
+            if (!State.World.IsValid())
+            {
+                UE_LOG(LogGameJam, Warning, TEXT("Input %s stopped because its world went away."), State.bRecording ? TEXT("recording") : TEXT("replay"));
+                Stop();
+            }
+            return;
+        }
+
+        if (State.bRecording)
+        {
+            RecordFrame(World, DeltaSeconds);
+            return;
+        }
+
+        const double Now = FPlatformTime::Seconds();
+        if (!State.bFirstReplayFrame)
+        {
+            FFrameTiming& Timing = State.Timings.AddDefaulted_GetRef();
+            Timing.StepMs = State.CurrentStep * 1000.0;
+            Timing.FrameMs = (Now - State.LastFrameTime) * 1000.0;
+            Timing.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+            const AWorldManager* Manager = AWorldManager::Get(World);
+            Timing.WorldIndex = Manager ? static_cast<int32>(Manager->GetCurrentWorld()) : 0;
+        }
+        State.bFirstReplayFrame = false;
+        State.LastFrameTime = Now;
+
+        const bool bInjected = State.ResampleStep > 0.0f ? InjectNextResampledFrame(World) : InjectNextFrame(World);
+        if (!bInjected)
+        {
+            FinishReplay();
+        }
+    }
+
+    static void StartRecording(const FString& Cmd, UWorld* World)
+    {
+        if (State.bRecording || State.bReplaying)
+        {
+            UE_LOG(LogGameJam, Error, TEXT("GameJam.Input.Record: a recording or replay is already running."));
+            return;
+        }
+
+        UEnhancedInputComponent* Input = GetPawnInput(World);
+        if (!Input)
+        {
+            UE_LOG(LogGameJam, Error, TEXT("GameJam.Input.Record needs a possessed pawn using an Enhanced Input component."));
+            return;
+        }
+
+        State = FState();
+        State.Name = TEXT("InputReplay");
+        FParse::Value(*Cmd, TEXT("File="), State.Name);
+        State.World = World;
+
+        for (const TUniquePtr<FEnhancedInputActionEventBinding>& Binding : Input->GetActionEventBindings())
+        {
+            const UInputAction* Action = Binding ? Binding->GetAction() : nullptr;
+            if (Action && !State.Actions.Contains(Action) && State.Actions.Num() < MaxActions)
+            {
+                // Registers a value binding so GetBoundActionValue reports the action every frame.
+                Input->BindActionValue(Action);
+                State.Actions.Add(Action);
+                State.ActionPaths.Add(Action->GetPathName());
+                State.Values.Add(FInputActionValue(Action->ValueType, FVector::ZeroVector));
+            }
+        }
+
+        State.Writer = MakeUnique<FMemoryWriter>(State.Data);
+        State.bRecording = true;
+        State.TickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(&HandlePostActorTick);
+
+        UE_LOG(LogGameJam, Display, TEXT("Recording %d input actions to %s. Stop with GameJam.Input.Record Stop."), State.Actions.Num(),
+            *GetReplayPath(State.Name));
+    }
+
+    static void Record(const TArray<FString>& Args, UWorld* World)
+    {
+        const FString Verb = Args.Num() > 0 ? Args[0] : FString();
+        if (Verb.Equals(TEXT("Start"), ESearchCase::IgnoreCase))
+        {
+            StartRecording(FString::Join(Args, TEXT(" ")), World);
+        }
+        else if (Verb.Equals(TEXT("Stop"), ESearchCase::IgnoreCase))
+        {
+            if (State.bRecording)
+            {
+                FinishRecording();
+            }
+            else
+            {
+                UE_LOG(LogGameJam, Warning, TEXT("GameJam.Input.Record Stop: no recording is running."));
+            }
+        }
+        else
+        {
+            UE_LOG(LogGameJam, Error, TEXT("Usage: GameJam.Input.Record Start [File=<name>] | Stop"));
+        }
+    }
+
+    static void Replay(const TArray<FString>& Args, UWorld* World)
+    {
+        if (State.bRecording || State.bReplaying)
+        {
+            UE_LOG(LogGameJam, Error, TEXT("GameJam.Input.Replay: a recording or replay is already running."));
+            return;
+        }
+
+        if (!World || !World->HasBegunPlay())
+        {
+            UE_LOG(LogGameJam, Error, TEXT("GameJam.Input.Replay needs a running game world."));
+            return;
+        }
+
+        const FString Cmd = FString::Join(Args, TEXT(" "));
+        State = FState();
+        State.Name = TEXT("InputReplay");
+        FParse::Value(*Cmd, TEXT("File="), State.Name);
+        FParse::Bool(*Cmd, TEXT("Exit="), State.bExitWhenDone);
+
+        const FString Path = GetReplayPath(State.Name);
+        TArray<uint8> File;
+        if (!FFileHelper::LoadFileToArray(File, *Path))
+        {
+            UE_LOG(LogGameJam, Error, TEXT("GameJam.Input.Replay could not read %s."), *Path);
+            return;
+        }
+
+        FMemoryReader Header(File);
+        uint32 Magic = 0;
+        int32 Version = 0;
+        Header << Magic << Version;
+        if (Magic != FileMagic || Version != FileVersion)
+        {
+            UE_LOG(LogGameJam, Error, TEXT("GameJam.Input.Replay: %s is not a version %d input recording."), *Path, FileVersion);
+            return;
+        }
+
+        Header << State.NumFrames << State.ActionPaths;
+        if (Header.IsError() || State.ActionPaths.Num() > MaxActions)
+        {
+            UE_LOG(LogGameJam, Error, TEXT("GameJam.Input.Replay: %s is corrupt."), *Path);
+            return;
+        }
+
+        for (const FString& ActionPath : State.ActionPaths)
+        {
+            uint8 ValueType = 0;
+            Header << ValueType;
+
+            // Missing actions still take part in decoding so the stream stays aligned; they are just not injected.
+            const UInputAction* Action = LoadObject<UInputAction>(nullptr, *ActionPath);
+            if (!Action)
+            {
+                UE_LOG(LogGameJam, Warning, TEXT("GameJam.Input.Replay: action %s not found and will not be injected."), *ActionPath);
+            }
+
+            State.Actions.Add(Action);
+            State.Values.Add(FInputActionValue(static_cast<EInputActionValueType>(ValueType), FVector::ZeroVector));
+        }
+
+        State.Data = TArray<uint8>(File.GetData() + Header.Tell(), File.Num() - Header.Tell());
+        State.Reader = MakeUnique<FMemoryReader>(State.Data);
+
+        float Fps = 0.0f;
+        if (FParse::Value(*Cmd, TEXT("Fps="), Fps) && Fps > 0.0f)
+        {
+            State.ResampleStep = 1.0f / Fps;
+        }
+
+        // A fixed timestep makes every frame advance the simulation by the chosen step regardless of how long it took.
+        State.bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+        State.PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+        FApp::SetUseFixedTimeStep(true);
+        if (State.ResampleStep > 0.0f)
+        {
+            FApp::SetFixedDeltaTime(State.ResampleStep);
+        }
+
+        State.World = World;
+        State.Timings.Reserve(State.NumFrames);
+        State.bReplaying = true;
+        State.TickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(&HandlePostActorTick);
+
+        if (State.ResampleStep > 0.0f)
+        {
+            UE_LOG(LogGameJam, Display, TEXT("Replaying %d frames of input from %s resampled to %.1f fps."), State.NumFrames, *Path, Fps);
+        }
+        else
+        {
+            UE_LOG(LogGameJam, Display, TEXT("Replaying %d frames of input from %s with the recorded frame times."), State.NumFrames, *Path);
+        }
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs RecordCommand(
+        TEXT("GameJam.Input.Record"),
+        TEXT("Records the frame times and the player pawn's Enhanced Input action values to Saved/InputReplays. ")
+        TEXT("Args: Start [File=<name>] | Stop"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Record));
+
+    static FAutoConsoleCommandWithWorldAndArgs ReplayCommand(
+        TEXT("GameJam.Input.Replay"),
+        TEXT("Replays a recording from Saved/InputReplays under a fixed timestep and writes frame times to Saved/Perf as CSV. ")
+        TEXT("Uses the recorded frame times unless Fps is given. Args: File=<name> [Fps=<rate>] [Exit=<bool>]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Replay));
+}
+
+#endif
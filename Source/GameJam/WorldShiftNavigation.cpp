@@ -0,0 +1,74 @@
+#include "WorldShiftNavigation.h"
+
+#include "NavAreas/NavArea_Null.h"
+#include "NavigationData.h"
+
+TSubclassOf<UNavArea> UNavArea_WorldShift::GetAreaClass(uint8 WalkableWorldMask, bool bTimedSolid)
+{
+    // Only the worlds with authored area variants.
+    constexpr uint8 AreaWorldMask = (1u << 3) - 1;
+    WalkableWorldMask &= AreaWorldMask;
+    if (WalkableWorldMask == 0)
+    {
+        return UNavArea_Null::StaticClass();
+    }
+
+    // Indexed by WalkableWorldMask - 1.
+    static const TSubclassOf<UNavArea> SolidAreas[AreaWorldMask] =
+    {
+        UNavArea_WorldShift_L::StaticClass(),
+        UNavArea_WorldShift_S::StaticClass(),
+        UNavArea_WorldShift_LS::StaticClass(),
+        UNavArea_WorldShift_C::StaticClass(),
+        UNavArea_WorldShift_LC::StaticClass(),
+        UNavArea_WorldShift_SC::StaticClass(),
+        UNavArea_WorldShift_LSC::StaticClass()
+    };
+    static const TSubclassOf<UNavArea> TimedAreas[AreaWorldMask] =
+    {
+        UNavArea_WorldShiftTimed_L::StaticClass(),
+        UNavArea_WorldShiftTimed_S::StaticClass(),
+        UNavArea_WorldShiftTimed_LS::StaticClass(),
+        UNavArea_WorldShiftTimed_C::StaticClass(),
+        UNavArea_WorldShiftTimed_LC::StaticClass(),
+        UNavArea_WorldShiftTimed_SC::StaticClass(),
+        UNavArea_WorldShiftTimed_LSC::StaticClass()
+    };
+
+    return bTimedSolid ? TimedAreas[WalkableWorldMask - 1] : SolidAreas[WalkableWorldMask - 1];
+}
+
+void UNavArea_WorldShift::InitializeWorldArea(uint8 WalkableWorldMask, bool bTimedSolid)
+{
+    AreaFlags = static_cast<uint16>(WalkableWorldMask << WorldFlagsShift) | (bTimedSolid ? TimedSolidFlag : 0);
+
+    // One color channel per world, dimmed for timed areas, so the navmesh debug view shows membership.
+    const uint8 On = bTimedSolid ? 128 : 255;
+    DrawColor = FColor((WalkableWorldMask & 1) ? On : 32, (WalkableWorldMask & 2) ? On : 32, (WalkableWorldMask & 4) ? On : 32);
+}
+
+void FWorldShiftNavigationFilters::Bake(ANavigationData& InNavData)
+{
+    NavData = &InNavData;
+
+    const FSharedConstNavQueryFilter DefaultFilter = InNavData.GetDefaultQueryFilter();
+    if (!DefaultFilter.IsValid())
+    {
+        return;
+    }
+
+    const uint16 BaseIncludeFlags = DefaultFilter->GetIncludeFlags() & ~UNavArea_WorldShift::AllWorldShiftFlags;
+
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+    {
+        const uint16 IncludeFlags = BaseIncludeFlags | UNavArea_WorldShift::GetWorldFlag(static_cast<EWorldState>(WorldIndex));
+
+        for (int32 Phase = 0; Phase < 2; ++Phase)
+        {
+            FSharedNavQueryFilter Filter = DefaultFilter->GetCopy();
+            Filter->SetIncludeFlags(IncludeFlags);
+            Filter->SetExcludeFlags(DefaultFilter->GetExcludeFlags() | (Phase == 0 ? UNavArea_WorldShift::TimedSolidFlag : 0));
+            Filters[WorldIndex][Phase] = Filter;
+        }
+    }
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/Navigation/NavQueryFilter.h"
+#include "NavAreas/NavArea.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "WorldShiftTypes.h"
+#include "WorldShiftNavigation.generated.h"
+
+class ANavigationData;
+
+/**
+ * Navigation area marking shiftable geometry with the worlds it can be walked in. The navmesh is baked once
+ * with every shiftable present; per-world query filters then include only the polygons of the active world,
+ * so a shift never rebuilds tiles.
+ *
+ * World flags live in the top bits of the area flags so designer areas keep the low bits.
+ */
+UCLASS(Abstract)
+class GAMEJAM_API UNavArea_WorldShift : public UNavArea
+{
+    GENERATED_BODY()
+
+public:
+    /** Area flag of the first world. World N uses WorldFlagsShift + N, leaving the top bit for TimedSolidFlag. */
+    static constexpr int32 WorldFlagsShift = 15 - WorldStateCount;
+
+    /** Area flag set on shiftables that are TimedSolid in any world; excluded while the timed solid phase is ghost. */
+    static constexpr uint16 TimedSolidFlag = 1u << 15;
+
+    /** Every flag owned by world shift areas. */
+    static constexpr uint16 AllWorldShiftFlags = ((WorldMaskCount - 1) << WorldFlagsShift) | TimedSolidFlag;
+
+    /** Returns the area flag of the supplied world. */
+    static uint16 GetWorldFlag(EWorldState World) { return static_cast<uint16>(1u << (WorldFlagsShift + static_cast<int32>(World))); }
+
+    /**
+     * Returns the area class for a shiftable walkable in the worlds of WalkableWorldMask, or the null area when it is
+     * walkable in none. TimedSolid shiftables use the timed variant, which drops out in every world while the phase
+     * is ghost; a shiftable that is Solid in one world and TimedSolid in another is therefore avoided conservatively.
+     * Area classes exist for the Light, Shadow and Chaos bits only; later worlds treat every shiftable as unwalkable
+     * until variants are added for them.
+     */
+    static TSubclassOf<UNavArea> GetAreaClass(uint8 WalkableWorldMask, bool bTimedSolid);
+
+protected:
+    /** Sets the area flags and debug color for the supplied world bitmask. */
+    void InitializeWorldArea(uint8 WalkableWorldMask, bool bTimedSolid);
+};
+
+/** Walkable in Light. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShift_L : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShift_L() { InitializeWorldArea(1, false); }
+};
+
+/** Walkable in Shadow. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShift_S : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShift_S() { InitializeWorldArea(2, false); }
+};
+
+/** Walkable in Light and Shadow. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShift_LS : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShift_LS() { InitializeWorldArea(3, false); }
+};
+
+/** Walkable in Chaos. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShift_C : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShift_C() { InitializeWorldArea(4, false); }
+};
+
+/** Walkable in Light and Chaos. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShift_LC : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShift_LC() { InitializeWorldArea(5, false); }
+};
+
+/** Walkable in Shadow and Chaos. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShift_SC : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShift_SC() { InitializeWorldArea(6, false); }
+};
+
+/** Walkable in Light and Shadow and Chaos. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShift_LSC : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShift_LSC() { InitializeWorldArea(7, false); }
+};
+
+/** Walkable in Light while the timed solid phase is solid. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShiftTimed_L : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShiftTimed_L() { InitializeWorldArea(1, true); }
+};
+
+/** Walkable in Shadow while the timed solid phase is solid. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShiftTimed_S : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShiftTimed_S() { InitializeWorldArea(2, true); }
+};
+
+/** Walkable in Light and Shadow while the timed solid phase is solid. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShiftTimed_LS : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShiftTimed_LS() { InitializeWorldArea(3, true); }
+};
+
+/** Walkable in Chaos while the timed solid phase is solid. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShiftTimed_C : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShiftTimed_C() { InitializeWorldArea(4, true); }
+};
+
+/** Walkable in Light and Chaos while the timed solid phase is solid. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShiftTimed_LC : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShiftTimed_LC() { InitializeWorldArea(5, true); }
+};
+
+/** Walkable in Shadow and Chaos while the timed solid phase is solid. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShiftTimed_SC : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShiftTimed_SC() { InitializeWorldArea(6, true); }
+};
+
+/** Walkable in Light and Shadow and Chaos while the timed solid phase is solid. */
+UCLASS()
+class GAMEJAM_API UNavArea_WorldShiftTimed_LSC : public UNavArea_WorldShift
+{
+    GENERATED_BODY()
+
+public:
+    UNavArea_WorldShiftTimed_LSC() { InitializeWorldArea(7, true); }
+};
+
+/**
+ * Query filter used by world-aware AI. AWorldManager replaces the instance stored on every navigation data with
+ * the filter baked for the active world and timed solid phase; without a manager it behaves like the default filter.
+ */
+UCLASS()
+class GAMEJAM_API UWorldShiftNavigationQueryFilter : public UNavigationQueryFilter
+{
+    GENERATED_BODY()
+};
+
+/** Query filters baked for every world and timed solid phase of one navigation data instance. */
+struct FWorldShiftNavigationFilters
+{
+    TWeakObjectPtr<ANavigationData> NavData;
+
+    /** Indexed by world, then by timed solid phase (0 ghost, 1 solid). */
+    FSharedNavQueryFilter Filters[WorldStateCount][2];
+
+    /** Derives the per-world filters from the navigation data's default filter. */
+    void Bake(ANavigationData& InNavData);
+};
@@ -0,0 +1,80 @@
+#include "WorldShiftProfile.h"
+
+#include "Materials/MaterialInterface.h"
+#include "UObject/Package.h"
+
+namespace
+{
+constexpr int32 GPrefabTypeCount = static_cast<int32>(EPlatformPrefabType::DeceptionPlatform) + 1;
+
+UWorldShiftProfile* CreatePrefabProfile(EPlatformPrefabType PrefabType)
+{
+    UWorldShiftProfile* Profile = NewObject<UWorldShiftProfile>(GetTransientPackage(), NAME_None, RF_Transient);
+
+    auto Configure = [Profile](EPlatformState LightState, EPlatformState ShadowState, EPlatformState ChaosState)
+    {
+        Profile->WorldBehaviors.Add(EWorldState::Light, LightState);
+        Profile->WorldBehaviors.Add(EWorldState::Shadow, ShadowState);
+        Profile->WorldBehaviors.Add(EWorldState::Chaos, ChaosState);
+    };
+
+    switch (PrefabType)
+    {
+    case EPlatformPrefabType::LightBridge:
+        Configure(EPlatformState::Solid, EPlatformState::Hidden, EPlatformState::Hidden);
+        break;
+    case EPlatformPrefabType::LightToShadow:
+        Configure(EPlatformState::Solid, EPlatformState::Ghost, EPlatformState::Hidden);
+        break;
+    case EPlatformPrefabType::ShadowBridge:
+        Configure(EPlatformState::Hidden, EPlatformState::Solid, EPlatformState::Hidden);
+        break;
+    case EPlatformPrefabType::ShadowIllusion:
+        Configure(EPlatformState::Solid, EPlatformState::Ghost, EPlatformState::Solid);
+        break;
+    case EPlatformPrefabType::ChaosFlicker:
+        Configure(EPlatformState::Hidden, EPlatformState::Hidden, EPlatformState::TimedSolid);
+        break;
+    case EPlatformPrefabType::ChaosTrap:
+        Configure(EPlatformState::Solid, EPlatformState::Solid, EPlatformState::Ghost);
+        break;
+    case EPlatformPrefabType::ChaosBridge:
+        Configure(EPlatformState::Hidden, EPlatformState::Hidden, EPlatformState::Solid);
+        break;
+    case EPlatformPrefabType::ShiftChain:
+        Configure(EPlatformState::Solid, EPlatformState::Solid, EPlatformState::TimedSolid);
+        break;
+    case EPlatformPrefabType::HiddenSurprise:
+        Configure(EPlatformState::Hidden, EPlatformState::Ghost, EPlatformState::Solid);
+        break;
+    case EPlatformPrefabType::DeceptionPlatform:
+        Configure(EPlatformState::Solid, EPlatformState::Ghost, EPlatformState::TimedSolid);
+        break;
+    default:
+        Configure(EPlatformState::Solid, EPlatformState::Ghost, EPlatformState::TimedSolid);
+        break;
+    }
+
+    // Prefab profiles are shared process-wide and never collected.
+    Profile->AddToRoot();
+    return Profile;
+}
+}
+
+UWorldShiftProfile* UWorldShiftProfile::GetPrefabProfile(EPlatformPrefabType PrefabType)
+{
+    static UWorldShiftProfile* PrefabProfiles[GPrefabTypeCount] = {};
+
+    const int32 PrefabIndex = static_cast<int32>(PrefabType);
+    if (PrefabIndex < 0 || PrefabIndex >= GPrefabTypeCount)
+    {
+        return nullptr;
+    }
+
+    if (!PrefabProfiles[PrefabIndex])
+    {
+        PrefabProfiles[PrefabIndex] = CreatePrefabProfile(PrefabType);
+    }
+
+    return PrefabProfiles[PrefabIndex];
+}
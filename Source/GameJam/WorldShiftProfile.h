@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ShiftPlatform.h"
+#include "WorldShiftTypes.h"
+#include "WorldShiftProfile.generated.h"
+
+class UMaterialInterface;
+
+/**
+ * Shared per-world behavior data referenced by many world shift components.
+ * Components only store their own map entries when an instance deviates from its profile.
+ */
+UCLASS(BlueprintType)
+class GAMEJAM_API UWorldShiftProfile : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /** Per-world behavior mapping. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift")
+    TMap<EWorldState, EPlatformState> WorldBehaviors;
+
+    /** Ghost materials keyed by the world they correspond to. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Materials")
+    TMap<EWorldState, TObjectPtr<UMaterialInterface>> GhostMaterials;
+
+    /** Hint materials keyed by the world where the platform becomes solid. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift|Materials")
+    TMap<EWorldState, TObjectPtr<UMaterialInterface>> GhostHintMaterials;
+
+    /** Returns the shared built-in profile for a platform prefab preset. */
+    static UWorldShiftProfile* GetPrefabProfile(EPlatformPrefabType PrefabType);
+};
@@ -0,0 +1,30 @@
+#include "WorldShiftStats.h"
+
+UE_TRACE_CHANNEL_DEFINE(WorldShiftChannel);
+
+DEFINE_STAT(STAT_WorldShiftSetWorld);
+DEFINE_STAT(STAT_WorldShiftResetWorld);
+DEFINE_STAT(STAT_WorldShiftRestoreLoopState);
+DEFINE_STAT(STAT_WorldShiftApplyFeedback);
+DEFINE_STAT(STAT_WorldShiftBroadcast);
+DEFINE_STAT(STAT_WorldShiftRegistryApply);
+DEFINE_STAT(STAT_WorldShiftProcessPending);
+DEFINE_STAT(STAT_WorldShiftTimedSolidDispatch);
+DEFINE_STAT(STAT_WorldShiftGhostHintPool);
+DEFINE_STAT(STAT_WorldShiftBehaviorApply);
+DEFINE_STAT(STAT_WorldShiftBehaviorTimedSolid);
+DEFINE_STAT(STAT_WorldShiftGhostPlayback);
+DEFINE_STAT(STAT_WorldShiftSerializeSave);
+
+DEFINE_STAT(STAT_WorldShiftShiftablesTouched);
+DEFINE_STAT(STAT_WorldShiftSkippedApplies);
+DEFINE_STAT(STAT_WorldShiftCollisionChanges);
+DEFINE_STAT(STAT_WorldShiftMaterialChanges);
+DEFINE_STAT(STAT_WorldShiftDelegateBroadcasts);
+DEFINE_STAT(STAT_WorldShiftStreamingMisses);
+DEFINE_STAT(STAT_WorldShiftCollapsedRequests);
+DEFINE_STAT(STAT_WorldShiftRestoredActors);
+
+DEFINE_STAT(STAT_WorldShiftConvergenceFrames);
+DEFINE_STAT(STAT_WorldShiftPendingBehaviors);
+DEFINE_STAT(STAT_WorldShiftGhostsSkipped);
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+/** Stat group shared by the world shift systems. Shown with "stat WorldShift". */
+DECLARE_STATS_GROUP(TEXT("WorldShift"), STATGROUP_WorldShift, STATCAT_Advanced);
+
+/** Insights channel for world shift CPU scopes. Enable with -trace=cpu,WorldShift. */
+UE_TRACE_CHANNEL_EXTERN(WorldShiftChannel, GAMEJAM_API);
+
+/** Times the enclosing scope in the WorldShift stat group and on the WorldShift trace channel. */
+#define WORLDSHIFT_SCOPE_CYCLE_COUNTER(Stat) \
+    SCOPE_CYCLE_COUNTER(Stat); \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, WorldShiftChannel)
+
+// Cycle stats
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Set World"), STAT_WorldShiftSetWorld, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Reset World"), STAT_WorldShiftResetWorld, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Restore Loop State"), STAT_WorldShiftRestoreLoopState, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply World Feedback"), STAT_WorldShiftApplyFeedback, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Broadcast World Shift"), STAT_WorldShiftBroadcast, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Registry Apply World"), STAT_WorldShiftRegistryApply, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Registry Process Pending"), STAT_WorldShiftProcessPending, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Timed Solid Dispatch"), STAT_WorldShiftTimedSolidDispatch, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ghost Hint Pool Update"), STAT_WorldShiftGhostHintPool, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Behavior Apply"), STAT_WorldShiftBehaviorApply, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Behavior Timed Solid"), STAT_WorldShiftBehaviorTimedSolid, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ghost Playback"), STAT_WorldShiftGhostPlayback, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serialize Save"), STAT_WorldShiftSerializeSave, STATGROUP_WorldShift, GAMEJAM_API);
+
+// Per-frame counters
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Shiftables Touched"), STAT_WorldShiftShiftablesTouched, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Skipped Platform Applies"), STAT_WorldShiftSkippedApplies, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Collision Changes"), STAT_WorldShiftCollisionChanges, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Material Changes"), STAT_WorldShiftMaterialChanges, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Delegate Broadcasts"), STAT_WorldShiftDelegateBroadcasts, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Streaming Preload Misses"), STAT_WorldShiftStreamingMisses, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Collapsed Shift Requests"), STAT_WorldShiftCollapsedRequests, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Restored Loop Actors"), STAT_WorldShiftRestoredActors, STATGROUP_WorldShift, GAMEJAM_API);
+
+// Values held until the next update
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Shift Convergence Frames"), STAT_WorldShiftConvergenceFrames, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Shift Pending Behaviors"), STAT_WorldShiftPendingBehaviors, STATGROUP_WorldShift, GAMEJAM_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Ghosts Over Budget"), STAT_WorldShiftGhostsSkipped, STATGROUP_WorldShift, GAMEJAM_API);
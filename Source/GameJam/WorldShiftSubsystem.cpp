@@ -0,0 +1,588 @@
+#include "WorldShiftSubsystem.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "Materials/MaterialInterface.h"
+#include "WorldManager.h"
+#include "WorldShiftBehaviorComponent.h"
+#include "WorldShiftStats.h"
+
+UWorldShiftSubsystem* UWorldShiftSubsystem::Get(const UWorld* World)
+{
+    return World ? World->GetSubsystem<UWorldShiftSubsystem>() : nullptr;
+}
+
+void UWorldShiftSubsystem::Deinitialize()
+{
+    for (FWorldShiftEntry& Entry : Entries)
+    {
+        if (Entry.Behavior)
+        {
+            Entry.Behavior->RegistryIndex = INDEX_NONE;
+        }
+    }
+
+    Entries.Reset();
+    EntryStateMasks.Reset();
+    ResolvedStates.Reset();
+    for (TArray<UWorldShiftBehaviorComponent*>& Participants : TimedSolidParticipants)
+    {
+        Participants.Reset();
+    }
+    TimedSolidMembers.Reset();
+    PendingBehaviors.Reset();
+    DeferredEntries.Reset();
+    DestroyGhostHintPool();
+    PendingCursor = 0;
+    OnWorldShiftedNative.Clear();
+    PendingWorldManagerCallbacks.Clear();
+    WorldManager.Reset();
+
+    Super::Deinitialize();
+}
+
+void UWorldShiftSubsystem::SetWorldManager(AWorldManager* Manager)
+{
+    if (!Manager)
+    {
+        return;
+    }
+
+    if (WorldManager.IsValid() && WorldManager.Get() != Manager)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Multiple world managers in %s; %s replaces %s."),
+            *GetNameSafe(GetWorld()), *GetNameSafe(Manager), *GetNameSafe(WorldManager.Get()));
+    }
+
+    WorldManager = Manager;
+
+    // Move the queue out first so callbacks that queue again are kept for the next manager.
+    FOnWorldManagerReadyNative Callbacks = MoveTemp(PendingWorldManagerCallbacks);
+    PendingWorldManagerCallbacks.Clear();
+    Callbacks.Broadcast(Manager);
+}
+
+void UWorldShiftSubsystem::ClearWorldManager(AWorldManager* Manager)
+{
+    if (WorldManager.Get() == Manager)
+    {
+        WorldManager.Reset();
+    }
+}
+
+void UWorldShiftSubsystem::WhenWorldManagerReady(FOnWorldManagerReadyNative::FDelegate&& Callback)
+{
+    if (AWorldManager* Manager = WorldManager.Get())
+    {
+        Callback.ExecuteIfBound(Manager);
+        return;
+    }
+
+    PendingWorldManagerCallbacks.Add(MoveTemp(Callback));
+}
+
+void UWorldShiftSubsystem::RegisterBehavior(UWorldShiftBehaviorComponent* Behavior)
+{
+    if (!Behavior || Behavior->RegistryIndex != INDEX_NONE)
+    {
+        return;
+    }
+
+    Behavior->RegistryIndex = Entries.Num();
+    Entries.AddDefaulted();
+    EntryStateMasks.AddDefaulted();
+    FillEntry(Behavior->RegistryIndex, Behavior);
+    AddTimedSolidParticipant(Behavior->RegistryIndex);
+    bGhostHintPoolDirty = true;
+}
+
+void UWorldShiftSubsystem::UnregisterBehavior(UWorldShiftBehaviorComponent* Behavior)
+{
+    if (!Behavior || !Entries.IsValidIndex(Behavior->RegistryIndex) || Entries[Behavior->RegistryIndex].Behavior != Behavior)
+    {
+        return;
+    }
+
+    for (int32 SlotIndex = 0; SlotIndex < GhostHintSlots.Num(); ++SlotIndex)
+    {
+        if (GhostHintSlots[SlotIndex].Behavior == Behavior)
+        {
+            ReleaseGhostHintSlot(SlotIndex);
+            bGhostHintPoolDirty = true;
+        }
+    }
+
+    const int32 PendingIndex = Entries[Behavior->RegistryIndex].PendingIndex;
+    if (PendingBehaviors.IsValidIndex(PendingIndex) && PendingBehaviors[PendingIndex] == Behavior)
+    {
+        PendingBehaviors[PendingIndex] = nullptr;
+    }
+
+    const int32 RemovedIndex = Behavior->RegistryIndex;
+    RemoveTimedSolidParticipant(Entries[RemovedIndex]);
+    Entries.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+    EntryStateMasks.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+    Behavior->RegistryIndex = INDEX_NONE;
+
+    if (Entries.IsValidIndex(RemovedIndex))
+    {
+        Entries[RemovedIndex].Behavior->RegistryIndex = RemovedIndex;
+    }
+}
+
+void UWorldShiftSubsystem::RefreshBehavior(UWorldShiftBehaviorComponent* Behavior)
+{
+    if (!Behavior || !Entries.IsValidIndex(Behavior->RegistryIndex))
+    {
+        return;
+    }
+
+    RemoveTimedSolidParticipant(Entries[Behavior->RegistryIndex]);
+    FillEntry(Behavior->RegistryIndex, Behavior);
+    AddTimedSolidParticipant(Behavior->RegistryIndex);
+    bGhostHintPoolDirty = true;
+}
+
+void UWorldShiftSubsystem::DispatchTimedSolidPhaseChanged(bool bNowSolid)
+{
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftTimedSolidDispatch);
+
+    UpdateTimedSolidMembership();
+
+    for (UWorldShiftBehaviorComponent* Behavior : TimedSolidParticipants[static_cast<int32>(CurrentWorld)])
+    {
+        Behavior->HandleGlobalTimedSolidPhaseChanged(bNowSolid);
+    }
+}
+
+void UWorldShiftSubsystem::DispatchTimedSolidPreWarning(bool bWillBeSolid)
+{
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftTimedSolidDispatch);
+
+    UpdateTimedSolidMembership();
+
+    for (UWorldShiftBehaviorComponent* Behavior : TimedSolidParticipants[static_cast<int32>(CurrentWorld)])
+    {
+        Behavior->HandleGlobalTimedSolidPreWarning(bWillBeSolid);
+    }
+}
+
+void UWorldShiftSubsystem::UpdateTimedSolidMembership()
+{
+    for (UWorldShiftBehaviorComponent* Behavior : TimedSolidMembers)
+    {
+        Behavior->UpdateMembershipChannel();
+    }
+}
+
+void UWorldShiftSubsystem::AddTimedSolidParticipant(int32 EntryIndex)
+{
+    FWorldShiftEntry& Entry = Entries[EntryIndex];
+    const uint8 TimedSolidMask = EntryStateMasks[EntryIndex].TimedSolid;
+
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+    {
+        if (TimedSolidMask & (1u << WorldIndex))
+        {
+            Entry.TimedSolidSlots[WorldIndex] = TimedSolidParticipants[WorldIndex].Add(Entry.Behavior);
+        }
+    }
+
+    if (TimedSolidMask != 0 && Entry.Behavior->bUseWorldCollisionChannels)
+    {
+        Entry.MembershipSlot = TimedSolidMembers.Add(Entry.Behavior);
+    }
+}
+
+void UWorldShiftSubsystem::RemoveTimedSolidParticipant(FWorldShiftEntry& Entry)
+{
+    // Swap-remove and point the moved behavior's entry at its new slot, mirroring UnregisterBehavior.
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+    {
+        int32& Slot = Entry.TimedSolidSlots[WorldIndex];
+        if (Slot == INDEX_NONE)
+        {
+            continue;
+        }
+
+        TArray<UWorldShiftBehaviorComponent*>& Participants = TimedSolidParticipants[WorldIndex];
+        Participants.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+        if (Participants.IsValidIndex(Slot))
+        {
+            Entries[Participants[Slot]->RegistryIndex].TimedSolidSlots[WorldIndex] = Slot;
+        }
+        Slot = INDEX_NONE;
+    }
+
+    if (Entry.MembershipSlot != INDEX_NONE)
+    {
+        TimedSolidMembers.RemoveAtSwap(Entry.MembershipSlot, 1, EAllowShrinking::No);
+        if (TimedSolidMembers.IsValidIndex(Entry.MembershipSlot))
+        {
+            Entries[TimedSolidMembers[Entry.MembershipSlot]->RegistryIndex].MembershipSlot = Entry.MembershipSlot;
+        }
+        Entry.MembershipSlot = INDEX_NONE;
+    }
+}
+
+void UWorldShiftSubsystem::ApplyWorld(EWorldState NewWorld, bool bAllowTimeSlicing)
+{
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftRegistryApply);
+
+    CurrentWorld = NewWorld;
+    bHasAppliedWorld = true;
+
+    bGhostHintPoolDirty = true;
+
+    // A newer shift supersedes whatever was still queued from the previous one.
+    PendingBehaviors.Reset();
+    PendingCursor = 0;
+    PendingFrames = 1;
+
+    if (bAllowTimeSlicing && TimeSlicing.bEnabled)
+    {
+        ApplyPrioritized();
+    }
+    else
+    {
+        ResolveStates(NewWorld);
+        for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+        {
+            ApplyEntry(Entries[EntryIndex], ResolvedStates[EntryIndex]);
+        }
+
+        LastConvergenceFrames = 1;
+        SET_DWORD_STAT(STAT_WorldShiftConvergenceFrames, LastConvergenceFrames);
+    }
+
+    INC_DWORD_STAT(STAT_WorldShiftDelegateBroadcasts);
+    OnWorldShiftedNative.Broadcast(NewWorld);
+}
+
+void UWorldShiftSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (IsApplyPending())
+    {
+        ++PendingFrames;
+        ProcessPending();
+    }
+
+    if (IsGhostHintPoolActive())
+    {
+        GhostHintUpdateAccumulator += DeltaTime;
+        if (bGhostHintPoolDirty || GhostHintUpdateAccumulator >= GhostHintPool.UpdateInterval)
+        {
+            GhostHintUpdateAccumulator = 0.0f;
+            bGhostHintPoolDirty = false;
+            UpdateGhostHintPool();
+        }
+    }
+}
+
+void UWorldShiftSubsystem::SetGhostHintPool(const FWorldShiftGhostHintPool& InGhostHintPool)
+{
+    DestroyGhostHintPool();
+    GhostHintPool = InGhostHintPool;
+    bGhostHintPoolDirty = true;
+}
+
+void UWorldShiftSubsystem::UpdateGhostHintPool()
+{
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftGhostHintPool);
+
+    if (GhostHintMeshes.Num() != GhostHintPool.PoolSize)
+    {
+        DestroyGhostHintPool();
+
+        for (int32 SlotIndex = 0; SlotIndex < GhostHintPool.PoolSize; ++SlotIndex)
+        {
+            UStaticMeshComponent* HintMesh = NewObject<UStaticMeshComponent>(this);
+            HintMesh->SetMobility(EComponentMobility::Movable);
+            HintMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+            HintMesh->SetCastShadow(false);
+            HintMesh->SetVisibility(false);
+            HintMesh->RegisterComponentWithWorld(GetWorld());
+
+            GhostHintMeshes.Add(HintMesh);
+        }
+
+        GhostHintSlots.SetNum(GhostHintPool.PoolSize);
+    }
+
+    const int32 WorldIndex = static_cast<int32>(CurrentWorld);
+
+    GhostHintCandidates.Reset();
+    if (const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0))
+    {
+        const FVector PlayerLocation = PlayerPawn->GetActorLocation();
+        const float MaxDistanceSquared = FMath::Square(GhostHintPool.MaxDistance);
+
+        for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+        {
+            const FWorldShiftEntry& Entry = Entries[EntryIndex];
+            if (Entry.HintWorlds[WorldIndex] == INDEX_NONE || !Entry.TargetMesh)
+            {
+                continue;
+            }
+
+            const float DistanceSquared = FVector::DistSquared(Entry.TargetMesh->Bounds.Origin, PlayerLocation);
+            if (DistanceSquared <= MaxDistanceSquared)
+            {
+                GhostHintCandidates.Emplace(DistanceSquared, EntryIndex);
+            }
+        }
+
+        if (GhostHintCandidates.Num() > GhostHintPool.PoolSize)
+        {
+            GhostHintCandidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B)
+            {
+                return A.Key < B.Key;
+            });
+            GhostHintCandidates.SetNum(GhostHintPool.PoolSize, EAllowShrinking::No);
+        }
+    }
+
+    // Keep slots that still point at a selected behavior so hints don't flicker between updates.
+    for (int32 SlotIndex = 0; SlotIndex < GhostHintSlots.Num(); ++SlotIndex)
+    {
+        const FGhostHintSlot& Slot = GhostHintSlots[SlotIndex];
+        if (!Slot.Behavior)
+        {
+            continue;
+        }
+
+        const bool bStillSelected = GhostHintCandidates.ContainsByPredicate([this, &Slot, WorldIndex](const TPair<float, int32>& Candidate)
+        {
+            const FWorldShiftEntry& Entry = Entries[Candidate.Value];
+            return Entry.Behavior == Slot.Behavior && Entry.HintWorlds[WorldIndex] == Slot.HintWorldIndex;
+        });
+
+        if (!bStillSelected)
+        {
+            ReleaseGhostHintSlot(SlotIndex);
+        }
+    }
+
+    int32 FreeSlotIndex = 0;
+    for (const TPair<float, int32>& Candidate : GhostHintCandidates)
+    {
+        const FWorldShiftEntry& Entry = Entries[Candidate.Value];
+        if (GhostHintSlots.ContainsByPredicate([&Entry](const FGhostHintSlot& Slot) { return Slot.Behavior == Entry.Behavior; }))
+        {
+            continue;
+        }
+
+        while (FreeSlotIndex < GhostHintSlots.Num() && GhostHintSlots[FreeSlotIndex].Behavior)
+        {
+            ++FreeSlotIndex;
+        }
+
+        if (FreeSlotIndex == GhostHintSlots.Num())
+        {
+            break;
+        }
+
+        FGhostHintSlot& Slot = GhostHintSlots[FreeSlotIndex];
+        Slot.Behavior = Entry.Behavior;
+        Slot.HintWorldIndex = Entry.HintWorlds[WorldIndex];
+
+        UStaticMeshComponent* HintMesh = GhostHintMeshes[FreeSlotIndex];
+        HintMesh->EmptyOverrideMaterials();
+        HintMesh->SetStaticMesh(Entry.TargetMesh->GetStaticMesh());
+        HintMesh->SetWorldTransform(Entry.TargetMesh->GetComponentTransform());
+
+        // FillEntry only keeps hint worlds that have a material.
+        UMaterialInterface* HintMaterial = Entry.Behavior->GetGhostHintMaterial(Slot.HintWorldIndex);
+        const int32 MaterialCount = HintMesh->GetNumMaterials();
+        for (int32 MaterialIndex = 0; MaterialIndex < MaterialCount; ++MaterialIndex)
+        {
+            HintMesh->SetMaterial(MaterialIndex, HintMaterial);
+        }
+
+        HintMesh->SetVisibility(true);
+    }
+}
+
+void UWorldShiftSubsystem::ReleaseGhostHintSlot(int32 SlotIndex)
+{
+    GhostHintSlots[SlotIndex] = FGhostHintSlot();
+
+    if (UStaticMeshComponent* HintMesh = GhostHintMeshes[SlotIndex])
+    {
+        HintMesh->SetVisibility(false);
+        HintMesh->EmptyOverrideMaterials();
+    }
+}
+
+void UWorldShiftSubsystem::DestroyGhostHintPool()
+{
+    for (UStaticMeshComponent* HintMesh : GhostHintMeshes)
+    {
+        if (HintMesh)
+        {
+            HintMesh->DestroyComponent();
+        }
+    }
+
+    GhostHintMeshes.Reset();
+    GhostHintSlots.Reset();
+}
+
+TStatId UWorldShiftSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UWorldShiftSubsystem, STATGROUP_Tickables);
+}
+
+void UWorldShiftSubsystem::ResolveStates(EWorldState World)
+{
+    const int32 NumEntries = EntryStateMasks.Num();
+    ResolvedStates.SetNumUninitialized(NumEntries, EAllowShrinking::No);
+
+    const uint8 WorldBit = GetWorldBit(World);
+    const FWorldStateMasks* Masks = EntryStateMasks.GetData();
+    EPlatformState* States = ResolvedStates.GetData();
+    for (int32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex)
+    {
+        States[EntryIndex] = Masks[EntryIndex].GetForBit(WorldBit);
+    }
+}
+
+void UWorldShiftSubsystem::ApplyEntry(FWorldShiftEntry& Entry, EPlatformState NewState)
+{
+    Entry.Behavior->ApplyWorldShift(CurrentWorld, NewState);
+    Entry.CurrentState = Entry.Behavior->CurrentState;
+}
+
+void UWorldShiftSubsystem::ApplyEntryAt(int32 EntryIndex)
+{
+    ApplyEntry(Entries[EntryIndex], EntryStateMasks[EntryIndex].Get(CurrentWorld));
+}
+
+void UWorldShiftSubsystem::ApplyPrioritized()
+{
+    const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+
+    FVector PlayerLocation = FVector::ZeroVector;
+    float ImmediateRadius = TimeSlicing.ImmediateRadius;
+    if (PlayerPawn)
+    {
+        PlayerLocation = PlayerPawn->GetActorLocation();
+        ImmediateRadius += FMath::Max(PlayerPawn->GetSimpleCollisionRadius(), PlayerPawn->GetSimpleCollisionHalfHeight());
+        ImmediateRadius += PlayerPawn->GetVelocity().Size() * TimeSlicing.VelocityLookaheadSeconds;
+    }
+
+    DeferredEntries.Reset();
+    float MaxDeferredDistance = 0.0f;
+
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+    {
+        FWorldShiftEntry& Entry = Entries[EntryIndex];
+        Entry.PendingIndex = INDEX_NONE;
+
+        float Distance = 0.0f;
+        if (PlayerPawn && Entry.TargetMesh)
+        {
+            const FBoxSphereBounds& Bounds = Entry.TargetMesh->Bounds;
+            Distance = FMath::Max(0.0f, FVector::Dist(Bounds.Origin, PlayerLocation) - Bounds.SphereRadius);
+        }
+
+        if (PlayerPawn && Distance <= ImmediateRadius)
+        {
+            ApplyEntryAt(EntryIndex);
+        }
+        else
+        {
+            DeferredEntries.Emplace(Distance, EntryIndex);
+            MaxDeferredDistance = FMath::Max(MaxDeferredDistance, Distance);
+        }
+    }
+
+    // A frame's budget covers many entries, so ordering by distance band is enough; a counting sort into the bands
+    // is linear and never compares entries.
+    constexpr int32 NumDistanceBands = 32;
+    const float BandScale = MaxDeferredDistance > 0.0f ? (NumDistanceBands - 1) / MaxDeferredDistance : 0.0f;
+    auto GetBand = [BandScale](float Distance)
+    {
+        return FMath::Min(FMath::FloorToInt(Distance * BandScale), NumDistanceBands - 1);
+    };
+
+    int32 BandStarts[NumDistanceBands + 1] = {};
+    for (const TPair<float, int32>& Deferred : DeferredEntries)
+    {
+        ++BandStarts[GetBand(Deferred.Key) + 1];
+    }
+
+    for (int32 Band = 1; Band <= NumDistanceBands; ++Band)
+    {
+        BandStarts[Band] += BandStarts[Band - 1];
+    }
+
+    PendingBehaviors.SetNumUninitialized(DeferredEntries.Num(), EAllowShrinking::No);
+    for (const TPair<float, int32>& Deferred : DeferredEntries)
+    {
+        FWorldShiftEntry& Entry = Entries[Deferred.Value];
+        Entry.PendingIndex = BandStarts[GetBand(Deferred.Key)]++;
+        PendingBehaviors[Entry.PendingIndex] = Entry.Behavior;
+    }
+
+    ProcessPending();
+}
+
+void UWorldShiftSubsystem::ProcessPending()
+{
+    WORLDSHIFT_SCOPE_CYCLE_COUNTER(STAT_WorldShiftProcessPending);
+
+    constexpr int32 EntriesPerTimeCheck = 16;
+
+    const double StartTime = FPlatformTime::Seconds();
+    const double BudgetSeconds = TimeSlicing.BudgetMicroseconds * 1.0e-6;
+
+    while (PendingCursor < PendingBehaviors.Num())
+    {
+        if (UWorldShiftBehaviorComponent* Behavior = PendingBehaviors[PendingCursor])
+        {
+            Entries[Behavior->RegistryIndex].PendingIndex = INDEX_NONE;
+            ApplyEntryAt(Behavior->RegistryIndex);
+        }
+
+        ++PendingCursor;
+
+        if (PendingCursor % EntriesPerTimeCheck == 0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+        {
+            break;
+        }
+    }
+
+    SET_DWORD_STAT(STAT_WorldShiftPendingBehaviors, PendingBehaviors.Num() - PendingCursor);
+
+    if (PendingCursor < PendingBehaviors.Num())
+    {
+        return;
+    }
+
+    PendingBehaviors.Reset();
+    PendingCursor = 0;
+    LastConvergenceFrames = PendingFrames;
+    SET_DWORD_STAT(STAT_WorldShiftConvergenceFrames, LastConvergenceFrames);
+}
+
+void UWorldShiftSubsystem::FillEntry(int32 EntryIndex, UWorldShiftBehaviorComponent* Behavior)
+{
+    FWorldShiftEntry& Entry = Entries[EntryIndex];
+    Entry.Behavior = Behavior;
+    Entry.TargetMesh = Behavior->TargetMesh;
+    Entry.CurrentState = Behavior->CurrentState;
+    EntryStateMasks[EntryIndex] = Behavior->GetWorldStateMasks();
+
+    const bool bUsesHintPool = Behavior->UsesSharedGhostHintPool();
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+    {
+        // Pooled hints are a copy of the target mesh, so without a hint material they would look like the platform itself.
+        const int32 HintWorldIndex = bUsesHintPool ? Behavior->GetGhostHintWorldIndex(static_cast<EWorldState>(WorldIndex)) : INDEX_NONE;
+        Entry.HintWorlds[WorldIndex] = HintWorldIndex != INDEX_NONE && Behavior->GetGhostHintMaterial(HintWorldIndex) ? HintWorldIndex : INDEX_NONE;
+    }
+}
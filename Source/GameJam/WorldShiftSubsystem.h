@@ -0,0 +1,293 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ShiftPlatform.h"
+#include "WorldShiftTypes.h"
+#include "WorldShiftSubsystem.generated.h"
+
+class AWorldManager;
+class UStaticMeshComponent;
+class UWorldShiftBehaviorComponent;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnWorldShiftedNative, EWorldState /*NewWorld*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnWorldManagerReadyNative, AWorldManager* /*Manager*/);
+
+/**
+ * Registry row for a single world-shift behavior. Rows are stored contiguously so a world
+ * change can be applied in one pass without going through dynamic delegates. The per-world
+ * states live in a parallel array of FWorldStateMasks so they can be decoded in bulk.
+ */
+struct FWorldShiftEntry
+{
+    FWorldShiftEntry()
+    {
+        for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+        {
+            TimedSolidSlots[WorldIndex] = INDEX_NONE;
+            HintWorlds[WorldIndex] = INDEX_NONE;
+        }
+    }
+
+    /** Behavior component that owns this row. Rows are removed before the component ends play. */
+    UWorldShiftBehaviorComponent* Behavior = nullptr;
+
+    /** Mesh driven by the behavior component. */
+    UStaticMeshComponent* TargetMesh = nullptr;
+
+    /** State applied by the last batched pass. */
+    EPlatformState CurrentState = EPlatformState::Solid;
+
+    /** Slot in the per-world TimedSolid participant lists, or INDEX_NONE. */
+    int32 TimedSolidSlots[WorldStateCount];
+
+    /** Slot in the collision-channel membership list, or INDEX_NONE. */
+    int32 MembershipSlot = INDEX_NONE;
+
+    /** Slot in the subsystem's pending list while the entry waits for a time-sliced shift, or INDEX_NONE. */
+    int32 PendingIndex = INDEX_NONE;
+
+    /** Hinted world index drawn by the shared pool while each world is active, or INDEX_NONE when the pool draws nothing. */
+    int32 HintWorlds[WorldStateCount];
+};
+
+/** Pooled ghost hint mesh and the behavior it is currently drawn for. */
+struct FGhostHintSlot
+{
+    UWorldShiftBehaviorComponent* Behavior = nullptr;
+
+    /** Hinted world the slot's material was set up for. */
+    int32 HintWorldIndex = INDEX_NONE;
+};
+
+/** Settings for spreading a world shift over several frames. */
+USTRUCT(BlueprintType)
+struct FWorldShiftTimeSlicing
+{
+    GENERATED_BODY()
+
+    /** Applies shiftables far from the player over several frames when enabled. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift")
+    bool bEnabled = false;
+
+    /** Game-thread time spent per frame on deferred shiftables, in microseconds. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift", meta = (EditCondition = "bEnabled", ClampMin = "1.0"))
+    float BudgetMicroseconds = 1000.0f;
+
+    /** Shiftables whose bounds lie within this distance of the player are always applied in the shift frame. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift", meta = (EditCondition = "bEnabled", ClampMin = "0.0"))
+    float ImmediateRadius = 1500.0f;
+
+    /** Seconds of player velocity added to ImmediateRadius so the upcoming capsule sweep is covered. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift", meta = (EditCondition = "bEnabled", ClampMin = "0.0"))
+    float VelocityLookaheadSeconds = 0.25f;
+};
+
+/** Settings for the shared pool of ghost hint meshes. */
+USTRUCT(BlueprintType)
+struct FWorldShiftGhostHintPool
+{
+    GENERATED_BODY()
+
+    /** Draws ghost hints for the platforms nearest to the player from a fixed pool of meshes. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift")
+    bool bEnabled = true;
+
+    /** Number of pooled hint meshes, which is also the most hints visible at once. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift", meta = (EditCondition = "bEnabled", ClampMin = "0"))
+    int32 PoolSize = 16;
+
+    /** Platforms further than this from the player never receive a hint. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift", meta = (EditCondition = "bEnabled", ClampMin = "0.0"))
+    float MaxDistance = 4000.0f;
+
+    /** Seconds between reassignments as the player moves. World shifts reassign immediately. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift", meta = (EditCondition = "bEnabled", ClampMin = "0.0"))
+    float UpdateInterval = 0.25f;
+};
+
+/**
+ * World subsystem that keeps every world-shift behavior in a flat table and applies
+ * world changes as a single batched pass. Native systems listen through OnWorldShiftedNative;
+ * AWorldManager::OnWorldShifted is left for Blueprint listeners.
+ *
+ * The subsystem also owns the world's AWorldManager reference. It exists before any actor is
+ * initialized, so AWorldManager::Get is a lookup rather than an actor scan, and the reference
+ * cannot outlive its world the way a static would across PIE sessions.
+ *
+ * With time slicing enabled, shiftables near the player are applied in the shift frame and the
+ * rest are applied nearest-first under a per-frame budget. The logical world switches immediately.
+ */
+UCLASS()
+class GAMEJAM_API UWorldShiftSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Returns the subsystem for the supplied world, if any. */
+    static UWorldShiftSubsystem* Get(const UWorld* World);
+
+    /** Records the world's manager and runs every callback queued by WhenWorldManagerReady in one batch. */
+    void SetWorldManager(AWorldManager* Manager);
+
+    /** Forgets the manager if it is the one currently recorded. */
+    void ClearWorldManager(AWorldManager* Manager);
+
+    /** Returns the world's manager once it has initialized its components, otherwise null. */
+    AWorldManager* GetWorldManager() const { return WorldManager.Get(); }
+
+    /**
+     * Runs the callback right away if the manager is already known, otherwise queues it until SetWorldManager.
+     * Queued callbacks bound to an object are skipped if that object has been destroyed by then.
+     */
+    void WhenWorldManagerReady(FOnWorldManagerReadyNative::FDelegate&& Callback);
+
+    /** Adds the behavior component to the registry. */
+    void RegisterBehavior(UWorldShiftBehaviorComponent* Behavior);
+
+    /** Removes the behavior component from the registry. */
+    void UnregisterBehavior(UWorldShiftBehaviorComponent* Behavior);
+
+    /** Re-reads the per-world states and target mesh of an already registered behavior. */
+    void RefreshBehavior(UWorldShiftBehaviorComponent* Behavior);
+
+    /** Applies the supplied world to registered behaviors, then notifies native listeners. */
+    void ApplyWorld(EWorldState NewWorld, bool bAllowTimeSlicing = true);
+
+    /** Configures time-sliced application of later world shifts. */
+    void SetTimeSlicing(const FWorldShiftTimeSlicing& InTimeSlicing) { TimeSlicing = InTimeSlicing; }
+
+    /** Returns the time slicing settings used by later world shifts. */
+    const FWorldShiftTimeSlicing& GetTimeSlicing() const { return TimeSlicing; }
+
+    /** Configures the shared ghost hint pool and rebuilds it on the next tick. */
+    void SetGhostHintPool(const FWorldShiftGhostHintPool& InGhostHintPool);
+
+    /** Returns whether deferred behaviors from the last shift are still waiting to be applied. */
+    bool IsApplyPending() const { return PendingBehaviors.Num() > 0; }
+
+    /** Returns how many frames the last completed shift took to reach every behavior. */
+    int32 GetLastConvergenceFrames() const { return LastConvergenceFrames; }
+
+    /** Returns the last world applied by the registry. */
+    EWorldState GetCurrentWorld() const { return CurrentWorld; }
+
+    /** Returns whether ApplyWorld has run at least once for this world. */
+    bool HasAppliedWorld() const { return bHasAppliedWorld; }
+
+    /** Returns the number of registered behaviors. */
+    int32 GetNumBehaviors() const { return Entries.Num(); }
+
+    /** Forwards a global timed solid phase change to the behaviors that are TimedSolid in the current world. */
+    void DispatchTimedSolidPhaseChanged(bool bNowSolid);
+
+    /** Forwards the timed solid pre-warning to the behaviors that are TimedSolid in the current world. */
+    void DispatchTimedSolidPreWarning(bool bWillBeSolid);
+
+    /** Broadcast after every batched world change. */
+    FOnWorldShiftedNative OnWorldShiftedNative;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual bool IsTickable() const override { return IsApplyPending() || IsGhostHintPoolActive(); }
+
+protected:
+    virtual void Deinitialize() override;
+
+private:
+    /** Manager of this world, set from AWorldManager::PostInitializeComponents. */
+    TWeakObjectPtr<AWorldManager> WorldManager;
+
+    /** Callbacks waiting for the manager. Broadcast once and cleared when it registers. */
+    FOnWorldManagerReadyNative PendingWorldManagerCallbacks;
+
+    /** Copies the behavior's target, states and hint targets into the row at EntryIndex. */
+    void FillEntry(int32 EntryIndex, UWorldShiftBehaviorComponent* Behavior);
+
+    /** Adds the behavior to the TimedSolid participant lists of the row at EntryIndex. */
+    void AddTimedSolidParticipant(int32 EntryIndex);
+
+    /** Removes the behavior from every TimedSolid participant list. */
+    void RemoveTimedSolidParticipant(FWorldShiftEntry& Entry);
+
+    /** Refreshes membership channels of behaviors whose collision depends on the timed solid phase. */
+    void UpdateTimedSolidMembership();
+
+    bool IsGhostHintPoolActive() const { return GhostHintPool.bEnabled && GhostHintPool.PoolSize > 0 && bHasAppliedWorld; }
+
+    /** Assigns the pooled hint meshes to the nearest eligible behaviors around the player. */
+    void UpdateGhostHintPool();
+
+    /** Hides the pooled hint mesh and clears its assignment. */
+    void ReleaseGhostHintSlot(int32 SlotIndex);
+
+    /** Destroys the pooled hint meshes. */
+    void DestroyGhostHintPool();
+
+    /** Decodes every row's state for the supplied world into ResolvedStates in one branch-free pass. */
+    void ResolveStates(EWorldState World);
+
+    void ApplyEntry(FWorldShiftEntry& Entry, EPlatformState NewState);
+
+    /** Applies the current world to the row at EntryIndex, decoding its state on its own. */
+    void ApplyEntryAt(int32 EntryIndex);
+
+    /** Applies behaviors near the player and queues the rest by distance. */
+    void ApplyPrioritized();
+
+    /** Applies queued behaviors until the frame budget is used up. */
+    void ProcessPending();
+
+    /** Contiguous table of registered behaviors. */
+    TArray<FWorldShiftEntry> Entries;
+
+    /** Per-world states of every row, parallel to Entries. Kept separate so bulk passes stream over 4 bytes per row. */
+    TArray<FWorldStateMasks> EntryStateMasks;
+
+    /** Output of ResolveStates, parallel to Entries. Kept to avoid reallocating. */
+    TArray<EPlatformState> ResolvedStates;
+
+    /** Last world applied through ApplyWorld. */
+    EWorldState CurrentWorld = EWorldState::Light;
+
+    bool bHasAppliedWorld = false;
+
+    /** Behaviors that are TimedSolid in each world. A shift only changes which list receives phase events. */
+    TArray<UWorldShiftBehaviorComponent*> TimedSolidParticipants[WorldStateCount];
+
+    /** Collision-channel behaviors that are TimedSolid in any world; their membership follows the phase in every world. */
+    TArray<UWorldShiftBehaviorComponent*> TimedSolidMembers;
+
+    FWorldShiftTimeSlicing TimeSlicing;
+
+    /** Behaviors still waiting for the current world, nearest distance band first. Unregistered entries are nulled. */
+    TArray<UWorldShiftBehaviorComponent*> PendingBehaviors;
+
+    /** Distance and entry index of every deferred entry. Kept as a member so its capacity survives between shifts. */
+    TArray<TPair<float, int32>> DeferredEntries;
+
+    /** Next index into PendingBehaviors. */
+    int32 PendingCursor = 0;
+
+    /** Frames spent on the shift currently being applied. */
+    int32 PendingFrames = 0;
+
+    int32 LastConvergenceFrames = 0;
+
+    FWorldShiftGhostHintPool GhostHintPool;
+
+    /** Pooled hint meshes, created on the first pool update. */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UStaticMeshComponent>> GhostHintMeshes;
+
+    /** Assignment of every pooled hint mesh, parallel to GhostHintMeshes. */
+    TArray<FGhostHintSlot> GhostHintSlots;
+
+    /** Distance and entry index of the behaviors considered by the last pool update. Kept to avoid reallocating. */
+    TArray<TPair<float, int32>> GhostHintCandidates;
+
+    float GhostHintUpdateAccumulator = 0.0f;
+
+    /** Forces a pool update on the next tick, e.g. after a world shift. */
+    bool bGhostHintPoolDirty = true;
+};
@@ -3,14 +3,35 @@
 
 
 
+/** Worlds the player can shift between. New worlds go before MAX; cycling order comes from UWorldShiftWorldList. */
 UENUM(BlueprintType)
 enum class EWorldState : uint8
 {
     Light UMETA(DisplayName = "Light"),
     Shadow UMETA(DisplayName = "Shadow"),
-    Chaos UMETA(DisplayName = "Chaos")
+    Chaos UMETA(DisplayName = "Chaos"),
+    MAX UMETA(Hidden)
 };
 
+/** Number of world states, used to size per-world lookup tables. */
+constexpr int32 WorldStateCount = static_cast<int32>(EWorldState::MAX);
+
+/** World membership is stored as one uint8 bit per world. */
+constexpr int32 MaxWorldStates = 8;
+static_assert(WorldStateCount <= MaxWorldStates, "World bitmasks are uint8; widen them before adding more worlds.");
+
+/** Number of distinct world bitmasks (one bit per EWorldState value). */
+constexpr int32 WorldMaskCount = 1 << WorldStateCount;
+
+/** Bitmask with every world set. */
+constexpr uint8 AllWorldsMask = static_cast<uint8>(WorldMaskCount - 1);
+
+/** Returns the membership bit of the supplied world. */
+FORCEINLINE uint8 GetWorldBit(EWorldState World)
+{
+    return static_cast<uint8>(1u << static_cast<uint32>(World));
+}
+
 
 
 
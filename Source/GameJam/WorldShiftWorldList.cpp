@@ -0,0 +1,43 @@
+#include "WorldShiftWorldList.h"
+
+void UWorldShiftWorldList::BakeCycle(EWorldState (&OutNextWorlds)[WorldStateCount], EWorldState (&OutPreviousWorlds)[WorldStateCount]) const
+{
+    TArray<EWorldState, TInlineAllocator<MaxWorldStates>> Order;
+    uint8 ListedMask = 0;
+    for (const EWorldState World : CycleOrder)
+    {
+        if (static_cast<int32>(World) < WorldStateCount && !(ListedMask & GetWorldBit(World)))
+        {
+            ListedMask |= GetWorldBit(World);
+            Order.Add(World);
+        }
+    }
+
+    if (Order.Num() == 0)
+    {
+        BakeDefaultCycle(OutNextWorlds, OutPreviousWorlds);
+        return;
+    }
+
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+    {
+        OutNextWorlds[WorldIndex] = Order[0];
+        OutPreviousWorlds[WorldIndex] = Order[0];
+    }
+
+    for (int32 OrderIndex = 0; OrderIndex < Order.Num(); ++OrderIndex)
+    {
+        const int32 WorldIndex = static_cast<int32>(Order[OrderIndex]);
+        OutNextWorlds[WorldIndex] = Order[(OrderIndex + 1) % Order.Num()];
+        OutPreviousWorlds[WorldIndex] = Order[(OrderIndex + Order.Num() - 1) % Order.Num()];
+    }
+}
+
+void UWorldShiftWorldList::BakeDefaultCycle(EWorldState (&OutNextWorlds)[WorldStateCount], EWorldState (&OutPreviousWorlds)[WorldStateCount])
+{
+    for (int32 WorldIndex = 0; WorldIndex < WorldStateCount; ++WorldIndex)
+    {
+        OutNextWorlds[WorldIndex] = static_cast<EWorldState>((WorldIndex + 1) % WorldStateCount);
+        OutPreviousWorlds[WorldIndex] = static_cast<EWorldState>((WorldIndex + WorldStateCount - 1) % WorldStateCount);
+    }
+}
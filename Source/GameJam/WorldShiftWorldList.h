@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "WorldShiftTypes.h"
+#include "WorldShiftWorldList.generated.h"
+
+/**
+ * Data-driven list of the worlds a level cycles through. Lets levels ship a subset or a different order of
+ * the EWorldState values without code changes.
+ */
+UCLASS(BlueprintType)
+class GAMEJAM_API UWorldShiftWorldList : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /** Worlds in cycling order. Worlds left out are only reachable through AWorldManager::SetWorld. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "World Shift")
+    TArray<EWorldState> CycleOrder;
+
+    /**
+     * Resolves the next and previous world for every world index. Worlds outside the cycle step to the first
+     * listed world. An empty or invalid list cycles through every EWorldState in declaration order.
+     */
+    void BakeCycle(EWorldState (&OutNextWorlds)[WorldStateCount], EWorldState (&OutPreviousWorlds)[WorldStateCount]) const;
+
+    /** Fills the tables with the declaration order of EWorldState. */
+    static void BakeDefaultCycle(EWorldState (&OutNextWorlds)[WorldStateCount], EWorldState (&OutPreviousWorlds)[WorldStateCount]);
+};